@@ -0,0 +1,109 @@
+#include "BTree.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    template <int order>
+    int height(const BTree<int, int, order> & t) {
+        int h = 0;
+
+        for (Node<int, int, order>* node = t.getRoot(); node->getNumChildren() > 0; node = node->getChild(0)) {
+            ++h;
+        }
+
+        return h;
+    }
+
+    // Inserts, looks up and removes every key in random order, reporting
+    // the tree height and the average cost of each operation.
+    template <int order>
+    void sweep(const std::vector<int> & keys) {
+        BTree<int, int, order> t;
+        std::vector<int> queries = keys;
+        std::mt19937 rng(order);
+        std::shuffle(queries.begin(), queries.end(), rng);
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int k : keys) {
+            t.insert(k, k);
+        }
+
+        auto inserted = std::chrono::steady_clock::now();
+
+        long long found = 0;
+        for (int k : queries) {
+            found += (t.search(k) != nullptr);
+        }
+
+        auto searched = std::chrono::steady_clock::now();
+
+        int h = height(t);
+        long long bytes = t.getPool().getBytesReserved();
+
+        for (int k : queries) {
+            t.remove(k);
+        }
+
+        auto removed = std::chrono::steady_clock::now();
+
+        double n = keys.size();
+        std::cout << "order " << order
+                  << ": height = " << h
+                  << ", node pool = " << bytes / (1024 * 1024) << " MiB"
+                  << ", insert = " << std::chrono::duration<double, std::nano>(inserted - start).count() / n << " ns"
+                  << ", search = " << std::chrono::duration<double, std::nano>(searched - inserted).count() / n << " ns"
+                  << ", remove = " << std::chrono::duration<double, std::nano>(removed - searched).count() / n << " ns"
+                  << " (found " << found << ")" << std::endl;
+    }
+
+    // Compares building a tree by repeated insertion with the bulk-load
+    // constructor, from both sorted and shuffled input.
+    template <int order>
+    void build(const std::vector<int> & keys) {
+        std::vector<int> sortedKeys = keys;
+        std::sort(sortedKeys.begin(), sortedKeys.end());
+        std::vector<int> shuffledKeys = keys;
+
+        auto start = std::chrono::steady_clock::now();
+        BTree<int, int, order> inserted(sortedKeys.data(), sortedKeys.data(), sortedKeys.size());
+        auto insertDone = std::chrono::steady_clock::now();
+        BTree<int, int, order> loaded(sortedKeys.data(), sortedKeys.data(), sortedKeys.size(), true);
+        auto loadDone = std::chrono::steady_clock::now();
+        BTree<int, int, order> sorted(shuffledKeys.data(), shuffledKeys.data(), shuffledKeys.size(), false);
+        auto sortDone = std::chrono::steady_clock::now();
+
+        std::cout << "order " << order
+                  << ": insert loop = " << std::chrono::duration<double, std::milli>(insertDone - start).count() << " ms"
+                  << ", bulk load = " << std::chrono::duration<double, std::milli>(loadDone - insertDone).count() << " ms"
+                  << ", sort and bulk load = " << std::chrono::duration<double, std::milli>(sortDone - loadDone).count() << " ms"
+                  << " (heights " << height(inserted) << ", " << height(loaded) << ", " << height(sorted) << ")" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int inputSize = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+
+    std::vector<int> keys(inputSize);
+    for (int i = 0; i < inputSize; ++i) {
+        keys[i] = i;
+    }
+
+    std::mt19937 rng(42);
+    std::shuffle(keys.begin(), keys.end(), rng);
+
+    sweep<4>(keys);
+    sweep<8>(keys);
+    sweep<16>(keys);
+    sweep<32>(keys);
+    sweep<64>(keys);
+
+    build<4>(keys);
+    build<32>(keys);
+
+    return 0;
+}
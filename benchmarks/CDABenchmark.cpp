@@ -0,0 +1,317 @@
+#include "CDA.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+    struct LargeValue {
+        char bytes[256];
+
+        bool operator<(const LargeValue & other) const {
+            return std::memcmp(bytes, other.bytes, sizeof(bytes)) < 0;
+        }
+
+        bool operator>(const LargeValue & other) const {
+            return std::memcmp(bytes, other.bytes, sizeof(bytes)) > 0;
+        }
+    };
+
+    template <typename elmtype, typename function>
+    void run(const char* name, int inputSize, function make) {
+        auto start = std::chrono::steady_clock::now();
+
+        CDA<elmtype> c;
+        for (int i = 0; i < inputSize; ++i) {
+            c.AddEnd(make(i));
+        }
+
+        auto appended = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < inputSize; ++i) {
+            c.AddFront(make(i));
+        }
+
+        auto prepended = std::chrono::steady_clock::now();
+
+        while (c.Length() > 1) {
+            c.DelEnd();
+        }
+
+        auto shrunk = std::chrono::steady_clock::now();
+
+        double n = inputSize;
+        std::cout << name
+                  << ": AddEnd = " << std::chrono::duration<double, std::nano>(appended - start).count() / n << " ns"
+                  << ", AddFront = " << std::chrono::duration<double, std::nano>(prepended - appended).count() / n << " ns"
+                  << ", DelEnd = " << std::chrono::duration<double, std::nano>(shrunk - prepended).count() / (2 * n) << " ns"
+                  << std::endl;
+    }
+
+    // Uses the array as a queue that holds queueSize elements, then reads
+    // every element through operator[] and through Segments().
+    template <typename indexing>
+    void indexingCost(const char* name, int inputSize) {
+        int queueSize = 1000;
+        CDA<int, indexing> c;
+
+        for (int i = 0; i < queueSize; ++i) {
+            c.AddEnd(i);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < inputSize; ++i) {
+            c.AddEnd(i);
+            c.DelFront();
+        }
+
+        auto cycled = std::chrono::steady_clock::now();
+
+        long long sum = 0;
+        for (int pass = 0; pass < inputSize / queueSize; ++pass) {
+            for (int i = 0; i < queueSize; ++i) {
+                sum += c[i];
+            }
+        }
+
+        auto indexed = std::chrono::steady_clock::now();
+
+        for (int pass = 0; pass < inputSize / queueSize; ++pass) {
+            typename CDA<int, indexing>::Span span = c.Segments();
+
+            for (int i = 0; i < span.firstLength; ++i) {
+                sum += span.first[i];
+            }
+
+            for (int i = 0; i < span.secondLength; ++i) {
+                sum += span.second[i];
+            }
+        }
+
+        auto spanned = std::chrono::steady_clock::now();
+
+        double n = inputSize;
+        std::cout << name
+                  << ": AddEnd + DelFront = " << std::chrono::duration<double, std::nano>(cycled - start).count() / n << " ns"
+                  << ", operator[] = " << std::chrono::duration<double, std::nano>(indexed - cycled).count() / n << " ns"
+                  << ", Segments = " << std::chrono::duration<double, std::nano>(spanned - indexed).count() / n << " ns"
+                  << " (sum " << sum << ")" << std::endl;
+    }
+
+    // Swings the array between low and high elements over and over, like a
+    // queue whose depth oscillates, and counts the resizes it causes.
+    void oscillate(const char* name, const GrowthPolicy & policy, int inputSize) {
+        int low = 5;
+        int high = 17;
+        CDA<int> c;
+        c.SetGrowthPolicy(policy);
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int cycle = 0; cycle < inputSize / (2 * (high - low)); ++cycle) {
+            while (c.Length() < high) {
+                c.AddEnd(cycle);
+            }
+
+            while (c.Length() > low) {
+                c.DelFront();
+            }
+        }
+
+        auto finished = std::chrono::steady_clock::now();
+
+        std::cout << name
+                  << ": " << std::chrono::duration<double, std::nano>(finished - start).count() / inputSize << " ns per op"
+                  << ", " << c.Reallocations() << " reallocations" << std::endl;
+    }
+
+    // Sorts inputSize random elements with MergeSort on the given number of threads
+    template <typename elmtype, typename function>
+    void mergeSort(const char* name, int inputSize, int threads, function make) {
+        CDA<elmtype> c;
+        srand(1);
+
+        for (int i = 0; i < inputSize; ++i) {
+            c.AddEnd(make(rand()));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        c.MergeSort(threads);
+        auto finished = std::chrono::steady_clock::now();
+
+        std::cout << name << ", " << threads << " threads"
+                  << ": MergeSort = " << std::chrono::duration<double, std::milli>(finished - start).count() << " ms" << std::endl;
+    }
+
+    // Sorts inputSize random elements both ways with RadixSort on the given number of threads
+    template <typename elmtype>
+    void radixSort(const char* name, int inputSize, int threads) {
+        CDA<elmtype> c;
+        srand(1);
+
+        for (int i = 0; i < inputSize; ++i) {
+            c.AddEnd(static_cast<elmtype>(rand() - RAND_MAX / 2));
+        }
+
+        CDA<elmtype> copy(c);
+
+        auto start = std::chrono::steady_clock::now();
+        c.RadixSort(false, threads);
+        auto decreasing = std::chrono::steady_clock::now();
+        copy.RadixSort(true, threads);
+        auto increasing = std::chrono::steady_clock::now();
+
+        std::cout << name << ", " << threads << " threads"
+                  << ": RadixSort decreasing = " << std::chrono::duration<double, std::milli>(decreasing - start).count() << " ms"
+                  << ", increasing = " << std::chrono::duration<double, std::milli>(increasing - decreasing).count() << " ms" << std::endl;
+    }
+
+    // Sorts inputSize random integers from a range of range keys, copying and in place
+    void countingSort(int inputSize, int range) {
+        CDA<int> c;
+        srand(1);
+
+        for (int i = 0; i < inputSize; ++i) {
+            c.AddEnd(rand() % range - range / 2);
+        }
+
+        CDA<int> copy(c);
+
+        auto start = std::chrono::steady_clock::now();
+        c.CountingSort(range - range / 2 - 1, -range / 2);
+        auto copied = std::chrono::steady_clock::now();
+        copy.CountingSortInPlace(range - range / 2 - 1, -range / 2);
+        auto swapped = std::chrono::steady_clock::now();
+
+        std::cout << "int, " << range << " keys"
+                  << ": CountingSort = " << std::chrono::duration<double, std::milli>(copied - start).count() << " ms"
+                  << ", CountingSortInPlace = " << std::chrono::duration<double, std::milli>(swapped - copied).count() << " ms" << std::endl;
+    }
+
+    // Finds the 50th, 90th and 99th percentiles of inputSize random integers,
+    // rounds times over, with three calls to Select and with one to SelectMany
+    void percentiles(int inputSize, int rounds) {
+        CDA<int> values;
+        srand(1);
+
+        for (int i = 0; i < inputSize; ++i) {
+            values.AddEnd(rand());
+        }
+
+        int ks[] = {inputSize / 2, inputSize * 9 / 10, inputSize * 99 / 100};
+        int results[3];
+        long long sum = 0;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int round = 0; round < rounds; ++round) {
+            for (int k : ks) {
+                CDA<int> c(values);
+                sum += c.Select(k);
+            }
+        }
+
+        auto selected = std::chrono::steady_clock::now();
+
+        for (int round = 0; round < rounds; ++round) {
+            CDA<int> c(values);
+            c.SelectMany(ks, 3, results);
+
+            for (int result : results) {
+                sum += result;
+            }
+        }
+
+        auto selectedMany = std::chrono::steady_clock::now();
+
+        std::cout << "p50/p90/p99 of " << inputSize << " ints"
+                  << ": Select = " << std::chrono::duration<double, std::micro>(selected - start).count() / rounds << " us"
+                  << ", SelectMany = " << std::chrono::duration<double, std::micro>(selectedMany - selected).count() / rounds << " us"
+                  << " (sum " << sum << ")" << std::endl;
+    }
+
+    // Selects the median and searches for a value near the end of inputSize
+    // random integers on the given number of threads
+    void selectAndSearch(int inputSize, int threads) {
+        CDA<int> values;
+        srand(1);
+
+        for (int i = 0; i < inputSize; ++i) {
+            values.AddEnd(rand() % inputSize);
+        }
+
+        values.AddEnd(-1);
+        CDA<int> c(values);
+
+        auto start = std::chrono::steady_clock::now();
+        int median = c.Select(inputSize / 2, threads);
+        auto selected = std::chrono::steady_clock::now();
+        int index = values.Search(-1, threads);
+        auto searched = std::chrono::steady_clock::now();
+
+        std::cout << "int, " << threads << " threads"
+                  << ": Select = " << std::chrono::duration<double, std::milli>(selected - start).count() << " ms"
+                  << ", Search = " << std::chrono::duration<double, std::milli>(searched - selected).count() << " ms"
+                  << " (" << median << ", " << index << ")" << std::endl;
+    }
+}
+
+// Times appending, prepending and removing elements, which includes every
+// resize along the way, for a cheap type and two expensive ones.
+int main(int argc, char* argv[]) {
+    int inputSize = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+
+    run<int>("int", inputSize, [](int i) {
+        return i;
+    });
+
+    run<std::string>("std::string (64 chars)", inputSize, [](int i) {
+        return std::string(64, 'a' + i % 26);
+    });
+
+    run<LargeValue>("256-byte POD", inputSize, [](int i) {
+        LargeValue value;
+        std::memset(value.bytes, i, sizeof(value.bytes));
+        return value;
+    });
+
+    indexingCost<ModuloIndexing>("ModuloIndexing", inputSize);
+    indexingCost<MaskIndexing>("MaskIndexing", inputSize);
+
+    GrowthPolicy policy;
+    oscillate("default policy", policy, inputSize);
+
+    policy.shrinkThreshold = 0.125;
+    oscillate("shrink at 1/8", policy, inputSize);
+
+    policy.neverShrink = true;
+    oscillate("never shrink", policy, inputSize);
+
+    int threads = std::thread::hardware_concurrency();
+
+    for (int t = 1; t <= threads; t *= 2) {
+        mergeSort<int>("int", inputSize, t, [](int i) {
+            return i;
+        });
+
+        mergeSort<std::string>("std::string (16 chars)", inputSize, t, [](int i) {
+            return std::to_string(i) + std::string(6, 'a');
+        });
+
+        radixSort<int>("int", inputSize, t);
+        radixSort<long long>("long long", inputSize, t);
+        radixSort<double>("double", inputSize, t);
+        selectAndSearch(inputSize, t);
+    }
+
+    countingSort(inputSize, 1000);
+    countingSort(inputSize, 10000000);
+
+    percentiles(10000, 100);
+    percentiles(inputSize, 5);
+
+    return 0;
+}
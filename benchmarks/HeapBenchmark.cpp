@@ -0,0 +1,324 @@
+#include "Heap.h"
+#include "IndexedHeap.h"
+#include "PriorityQueue.h"
+#include "Element.h"
+#include "PairingHeap.h"
+#include "RadixHeap.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    // Runs three mixes of operations on a heap of the given arity:
+    // building it with inserts and then emptying it, a timer queue that
+    // keeps inputSize entries and replaces the earliest one each step, and
+    // an insert-heavy mix that inserts three keys for every one it extracts.
+    template <int arity>
+    void sweep(const std::vector<int> & keys) {
+        int n = keys.size();
+        long long sum = 0;
+
+        Heap<int, arity> h1;
+        auto start = std::chrono::steady_clock::now();
+
+        for (int k : keys) {
+            h1.insert(k);
+        }
+
+        auto inserted = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < n; ++i) {
+            sum += h1.extractMin();
+        }
+
+        auto extracted = std::chrono::steady_clock::now();
+
+        Heap<int, arity> h2(const_cast<int*>(keys.data()), n);
+        auto built = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < n; ++i) {
+            int now = h2.extractMin();
+            sum += now;
+            h2.insert(now + keys[i] % 1000);
+        }
+
+        auto cycled = std::chrono::steady_clock::now();
+
+        Heap<int, arity> h3;
+
+        for (int i = 0; i < n; ++i) {
+            h3.insert(keys[i]);
+
+            if (i % 4 == 3) {
+                sum += h3.extractMin();
+            }
+        }
+
+        auto mixed = std::chrono::steady_clock::now();
+
+        std::cout << "arity " << arity
+                  << ": insert = " << std::chrono::duration<double, std::nano>(inserted - start).count() / n << " ns"
+                  << ", extractMin = " << std::chrono::duration<double, std::nano>(extracted - inserted).count() / n << " ns"
+                  << ", heapify = " << std::chrono::duration<double, std::nano>(built - extracted).count() / n << " ns"
+                  << ", timer queue = " << std::chrono::duration<double, std::nano>(cycled - built).count() / n << " ns"
+                  << ", 3 inserts per extract = " << std::chrono::duration<double, std::nano>(mixed - cycled).count() / n << " ns"
+                  << " (sum " << sum << ")" << std::endl;
+    }
+
+    // Inserts and then extracts every key, for keys that are expensive to copy
+    template <int arity>
+    void strings(const std::vector<int> & keys) {
+        int n = keys.size();
+        std::vector<std::string> values;
+
+        for (int k : keys) {
+            values.push_back(std::to_string(k) + std::string(24, 'x'));
+        }
+
+        Heap<std::string, arity> h1;
+        auto start = std::chrono::steady_clock::now();
+
+        for (const std::string & v : values) {
+            h1.insert(v);
+        }
+
+        auto inserted = std::chrono::steady_clock::now();
+
+        long long length = 0;
+        for (int i = 0; i < n; ++i) {
+            length += h1.extractMin().size();
+        }
+
+        auto extracted = std::chrono::steady_clock::now();
+
+        std::cout << "arity " << arity << ", std::string"
+                  << ": insert = " << std::chrono::duration<double, std::nano>(inserted - start).count() / n << " ns"
+                  << ", extractMin = " << std::chrono::duration<double, std::nano>(extracted - inserted).count() / n << " ns"
+                  << " (length " << length << ")" << std::endl;
+    }
+
+    // Runs the same mixes through any heap with insert and extractMin, on
+    // keys that never drop below the last one extracted, so that RadixHeap
+    // can take part
+    template <typename heaptype>
+    void alternative(const char* name, const std::vector<int> & keys) {
+        int n = keys.size();
+        unsigned long long sum = 0;
+
+        heaptype h1;
+        auto start = std::chrono::steady_clock::now();
+
+        for (int k : keys) {
+            h1.insert(k);
+        }
+
+        auto inserted = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < n; ++i) {
+            sum += h1.extractMin();
+        }
+
+        auto extracted = std::chrono::steady_clock::now();
+
+        heaptype h2;
+
+        for (int k : keys) {
+            h2.insert(k);
+        }
+
+        auto refilled = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < n; ++i) {
+            unsigned int now = h2.extractMin();
+            sum += now;
+            h2.insert(now + keys[i] % 1000);
+        }
+
+        auto cycled = std::chrono::steady_clock::now();
+
+        heaptype h3;
+        unsigned int now = 0;
+
+        for (int i = 0; i < n; ++i) {
+            h3.insert(now + keys[i] % 1000000);
+
+            if (i % 4 == 3) {
+                now = h3.extractMin();
+                sum += now;
+            }
+        }
+
+        auto mixed = std::chrono::steady_clock::now();
+
+        std::cout << name
+                  << ": insert = " << std::chrono::duration<double, std::nano>(inserted - start).count() / n << " ns"
+                  << ", extractMin = " << std::chrono::duration<double, std::nano>(extracted - inserted).count() / n << " ns"
+                  << ", timer queue = " << std::chrono::duration<double, std::nano>(cycled - refilled).count() / n << " ns"
+                  << ", 3 inserts per extract = " << std::chrono::duration<double, std::nano>(mixed - cycled).count() / n << " ns"
+                  << " (sum " << sum << ")" << std::endl;
+    }
+
+    template <int bytes>
+    struct Payload {
+        char data[bytes];
+    };
+
+    // Inserts and then extracts keys with payloads of the given size, kept
+    // next to the key in a Heap of Elements, or out of line by PriorityQueue
+    template <int bytes>
+    void payloads(const std::vector<int> & keys) {
+        int n = keys.size();
+        long long sum = 0;
+
+        Heap<Element<int, Payload<bytes>>> h;
+        auto start = std::chrono::steady_clock::now();
+
+        for (int k : keys) {
+            h.insert(Element<int, Payload<bytes>>{k, Payload<bytes>{{(char) k}}});
+        }
+
+        for (int i = 0; i < n; ++i) {
+            sum += h.extractMin().value.data[0];
+        }
+
+        auto heapFinished = std::chrono::steady_clock::now();
+
+        PriorityQueue<int, Payload<bytes>> q;
+
+        for (int k : keys) {
+            q.insert(k, Payload<bytes>{{(char) k}});
+        }
+
+        for (int i = 0; i < n; ++i) {
+            sum -= q.extractMin().value.data[0];
+        }
+
+        auto queueFinished = std::chrono::steady_clock::now();
+
+        std::cout << bytes << "-byte payloads, insert and extractMin"
+                  << ": Heap of Elements = " << std::chrono::duration<double, std::nano>(heapFinished - start).count() / n << " ns"
+                  << ", PriorityQueue = " << std::chrono::duration<double, std::nano>(queueFinished - heapFinished).count() / n << " ns"
+                  << " (difference " << sum << ")" << std::endl;
+    }
+
+    // Lowers random entries' keys, then empties the heap, the way Dijkstra's
+    // algorithm does. Heap has to insert a duplicate for every update and skip
+    // stale entries when they come out, while IndexedHeap updates in place.
+    void decreaseKey(const std::vector<int> & keys) {
+        int n = keys.size();
+        std::vector<long long> current(keys.begin(), keys.end());
+        long long sum = 0;
+
+        // Keys are packed above the entry's index in the low 32 bits, so stale duplicates can be recognized
+        Heap<long long> lazy;
+        auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < n; ++i) {
+            lazy.insert(current[i] * (1LL << 32) + i);
+        }
+
+        for (int i = 0; i < 4 * n; ++i) {
+            int entry = keys[i % n] % n;
+            current[entry] -= keys[(i + 1) % n] % 1000;
+            lazy.insert(current[entry] * (1LL << 32) + entry);
+        }
+
+        for (int extracted = 0; extracted < n;) {
+            long long top = lazy.extractMin();
+            int entry = top & 0xffffffff;
+
+            if ((top >> 32) == current[entry]) {
+                current[entry] = std::numeric_limits<long long>::max();
+                sum += top >> 32;
+                ++extracted;
+            }
+        }
+
+        auto lazyFinished = std::chrono::steady_clock::now();
+
+        IndexedHeap<long long> indexed;
+        std::vector<int> handles(n);
+
+        for (int i = 0; i < n; ++i) {
+            handles[i] = indexed.insert(keys[i]);
+        }
+
+        for (int i = 0; i < 4 * n; ++i) {
+            int entry = keys[i % n] % n;
+            indexed.decreaseKey(handles[entry], indexed.getKey(handles[entry]) - keys[(i + 1) % n] % 1000);
+        }
+
+        for (int i = 0; i < n; ++i) {
+            sum -= indexed.extractMin();
+        }
+
+        auto indexedFinished = std::chrono::steady_clock::now();
+
+        PairingHeap<long long> pairing;
+        std::vector<PairingHeap<long long>::Handle> nodes(n);
+        std::vector<long long> pairingKeys(keys.begin(), keys.end());
+
+        for (int i = 0; i < n; ++i) {
+            nodes[i] = pairing.insert(keys[i]);
+        }
+
+        for (int i = 0; i < 4 * n; ++i) {
+            int entry = keys[i % n] % n;
+            pairingKeys[entry] -= keys[(i + 1) % n] % 1000;
+            pairing.decreaseKey(nodes[entry], pairingKeys[entry]);
+        }
+
+        for (int i = 0; i < n; ++i) {
+            sum += pairing.extractMin();
+        }
+
+        auto pairingFinished = std::chrono::steady_clock::now();
+
+        std::cout << "4 decreases per entry"
+                  << ": Heap with duplicates = " << std::chrono::duration<double, std::nano>(lazyFinished - start).count() / n << " ns"
+                  << ", IndexedHeap = " << std::chrono::duration<double, std::nano>(indexedFinished - lazyFinished).count() / n << " ns"
+                  << ", PairingHeap = " << std::chrono::duration<double, std::nano>(pairingFinished - indexedFinished).count() / n << " ns"
+                  << " (sum " << sum << ")" << std::endl;
+    }
+}
+
+// Times each mix on heaps of inputSize random keys for arities from 2 to 16,
+// then compares keeping payloads in the heap with keeping them out of line,
+// Heap against PairingHeap and RadixHeap, and updating keys in place
+// with inserting duplicates
+int main(int argc, char* argv[]) {
+    int inputSize = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+
+    std::vector<int> keys(inputSize);
+    std::mt19937 rng(1);
+
+    for (int & k : keys) {
+        k = rng() % 1000000000;
+    }
+
+    sweep<2>(keys);
+    sweep<3>(keys);
+    sweep<4>(keys);
+    sweep<8>(keys);
+    sweep<16>(keys);
+
+    strings<2>(keys);
+    strings<4>(keys);
+
+    payloads<8>(keys);
+    payloads<64>(keys);
+    payloads<256>(keys);
+
+    alternative<Heap<unsigned int>>("Heap", keys);
+    alternative<Heap<unsigned int, 4>>("4-ary Heap", keys);
+    alternative<PairingHeap<unsigned int>>("PairingHeap", keys);
+    alternative<RadixHeap<unsigned int>>("RadixHeap", keys);
+
+    decreaseKey(keys);
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+#include "CDA.h"
+#include "SPSCQueue.h"
+#include "GrowableSPSCQueue.h"
+#include "MPMCQueue.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    template <typename function>
+    void report(const char* name, int inputSize, function transfer) {
+        auto start = std::chrono::steady_clock::now();
+        transfer();
+        auto finished = std::chrono::steady_clock::now();
+
+        double seconds = std::chrono::duration<double>(finished - start).count();
+        std::cout << name << ": " << inputSize / seconds / 1e6 << " million messages per second" << std::endl;
+    }
+
+    // A CDA guarded by a mutex, for comparison
+    void mutexQueue(int inputSize) {
+        CDA<int> c;
+        std::mutex lock;
+
+        std::thread producer([&c, &lock, inputSize]() {
+            for (int i = 0; i < inputSize; ++i) {
+                std::lock_guard<std::mutex> guard(lock);
+                c.AddEnd(i);
+            }
+        });
+
+        long long sum = 0;
+        for (int received = 0; received < inputSize;) {
+            std::lock_guard<std::mutex> guard(lock);
+
+            while (c.Length() > 0) {
+                sum += c[0];
+                c.DelFront();
+                ++received;
+            }
+        }
+
+        producer.join();
+    }
+
+    void spscQueue(int inputSize) {
+        SPSCQueue<int> q(1024);
+
+        std::thread producer([&q, inputSize]() {
+            for (int i = 0; i < inputSize; ++i) {
+                while (!q.TryPush(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        long long sum = 0;
+        int v;
+
+        for (int received = 0; received < inputSize;) {
+            if (q.TryPop(v)) {
+                sum += v;
+                ++received;
+            }
+
+            else {
+                std::this_thread::yield();
+            }
+        }
+
+        producer.join();
+    }
+
+    void spscQueueBatch(int inputSize) {
+        SPSCQueue<int> q(1024);
+        const int batchSize = 64;
+
+        std::thread producer([&q, inputSize]() {
+            int items[batchSize];
+
+            for (int next = 0; next < inputSize; next += batchSize) {
+                for (int i = 0; i < batchSize; ++i) {
+                    items[i] = next + i;
+                }
+
+                for (int pushed = 0; pushed < batchSize;) {
+                    int count = q.PushBatch(items + pushed, batchSize - pushed);
+                    pushed += count;
+
+                    if (count == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        });
+
+        long long sum = 0;
+        int items[batchSize];
+
+        for (int received = 0; received < inputSize / batchSize * batchSize;) {
+            int count = q.PopBatch(items, batchSize);
+
+            for (int i = 0; i < count; ++i) {
+                sum += items[i];
+            }
+
+            received += count;
+
+            if (count == 0) {
+                std::this_thread::yield();
+            }
+        }
+
+        producer.join();
+    }
+
+    void growableQueue(int inputSize) {
+        GrowableSPSCQueue<int> q(1024);
+
+        std::thread producer([&q, inputSize]() {
+            for (int i = 0; i < inputSize; ++i) {
+                q.Push(i);
+            }
+        });
+
+        long long sum = 0;
+        int v;
+
+        for (int received = 0; received < inputSize;) {
+            if (q.TryPop(v)) {
+                sum += v;
+                ++received;
+            }
+
+            else {
+                std::this_thread::yield();
+            }
+        }
+
+        producer.join();
+    }
+
+    // Splits inputSize integers among numThreads producers and as many consumers
+    void mpmcQueue(int inputSize, int numThreads) {
+        MPMCQueue<int> q(1024);
+        int perThread = inputSize / numThreads;
+        std::vector<std::thread> threads;
+        std::vector<long long> sums(numThreads, 0);
+
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&q, perThread]() {
+                for (int i = 0; i < perThread; ++i) {
+                    q.Push(i);
+                }
+            });
+
+            threads.emplace_back([&q, &sums, perThread, t]() {
+                int v;
+
+                for (int i = 0; i < perThread; ++i) {
+                    q.Pop(v);
+                    sums[t] += v;
+                }
+            });
+        }
+
+        for (std::thread & t : threads) {
+            t.join();
+        }
+    }
+}
+
+// Passes inputSize integers from one thread to another through each queue,
+// then through an MPMCQueue shared by 1 up to maxThreads producer/consumer pairs
+int main(int argc, char* argv[]) {
+    int inputSize = (argc > 1) ? std::atoi(argv[1]) : 10000000;
+    int maxThreads = (argc > 2) ? std::atoi(argv[2]) : std::thread::hardware_concurrency();
+
+    if (maxThreads < 4) {
+        maxThreads = 4;
+    }
+
+    report("CDA with a mutex", inputSize, [inputSize]() { mutexQueue(inputSize); });
+    report("SPSCQueue", inputSize, [inputSize]() { spscQueue(inputSize); });
+    report("SPSCQueue, batches of 64", inputSize, [inputSize]() { spscQueueBatch(inputSize); });
+    report("GrowableSPSCQueue", inputSize, [inputSize]() { growableQueue(inputSize); });
+
+    for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+        std::string name = "MPMCQueue, " + std::to_string(numThreads) + " producers and consumers";
+        report(name.c_str(), inputSize / numThreads * numThreads, [inputSize, numThreads]() { mpmcQueue(inputSize, numThreads); });
+    }
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include "Two4Tree.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    struct LargeValue {
+        char bytes[256];
+    };
+
+    int height(const Two4Tree<int, int> & t) {
+        int h = 0;
+
+        for (Node<int, int>* node = t.getRoot(); node->getNumChildren() > 0; node = node->getChild(0)) {
+            ++h;
+        }
+
+        return h;
+    }
+
+    // Inserts every key and reports the most nodes a single insert added
+    // compared to the height of the tree at that point, and how many slabs
+    // the node pool had to allocate along the way.
+    void insertNodes(const char* name, const std::vector<int> & keys) {
+        Two4Tree<int, int> t;
+        int worst = 0;
+        int worstHeight = 0;
+        bool bounded = true;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int k : keys) {
+            int before = t.getPool().getLiveNodes();
+            t.insert(k, k);
+            int added = t.getPool().getLiveNodes() - before;
+            int h = height(t);
+
+            // A split adds one node per level, plus one for a new root
+            if (added > h + 1) {
+                bounded = false;
+            }
+
+            if (added > worst) {
+                worst = added;
+                worstHeight = h;
+            }
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / keys.size();
+
+        std::cout << name << ": n = " << keys.size()
+                  << ", height = " << height(t)
+                  << ", worst nodes added per insert = " << worst
+                  << " (height " << worstHeight << ")"
+                  << ", bounded by height + 1 = " << (bounded ? "yes" : "NO")
+                  << ", slabs = " << t.getPool().getSlabCount()
+                  << ", " << ns << " ns/insert" << std::endl;
+    }
+
+    // Times building a tree and tearing it down, which releases the node
+    // pool a slab at a time.
+    void buildAndTeardown(const std::vector<int> & keys) {
+        auto start = std::chrono::steady_clock::now();
+        Two4Tree<int, int>* t = new Two4Tree<int, int>;
+
+        for (int k : keys) {
+            t->insert(k, k);
+        }
+
+        auto built = std::chrono::steady_clock::now();
+
+        std::cout << "pool: live nodes = " << t->getPool().getLiveNodes()
+                  << ", slabs = " << t->getPool().getSlabCount()
+                  << ", bytes reserved = " << t->getPool().getBytesReserved() << std::endl;
+
+        int slabs = t->getPool().getSlabCount();
+        delete t;
+        auto end = std::chrono::steady_clock::now();
+
+        std::cout << "build: " << std::chrono::duration<double, std::milli>(built - start).count() << " ms"
+                  << ", teardown: " << std::chrono::duration<double, std::milli>(end - built).count() << " ms"
+                  << " (" << slabs << " slabs released)" << std::endl;
+    }
+
+    // Looks up every key in random order. Lookups only read keys, so the
+    // cost per level shouldn't depend on how big the values are.
+    template <typename valuetype>
+    void lookupLatency(const char* name, const std::vector<int> & keys) {
+        Two4Tree<int, valuetype> t;
+
+        for (int k : keys) {
+            t.insert(k, valuetype());
+        }
+
+        std::vector<int> queries = keys;
+        std::mt19937 rng(7);
+        std::shuffle(queries.begin(), queries.end(), rng);
+
+        long long found = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        for (int k : queries) {
+            found += (t.search(k) != nullptr);
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / queries.size();
+
+        std::cout << "lookup " << name << " (" << sizeof(Node<int, valuetype>) << " byte nodes): "
+                  << ns << " ns/lookup, found " << found << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int inputSize = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+
+    std::vector<int> keys(inputSize);
+    for (int i = 0; i < inputSize; ++i) {
+        keys[i] = i;
+    }
+
+    insertNodes("sequential", keys);
+
+    std::mt19937 rng(42);
+    std::shuffle(keys.begin(), keys.end(), rng);
+    insertNodes("random", keys);
+
+    buildAndTeardown(keys);
+
+    lookupLatency<int>("int values", keys);
+    lookupLatency<LargeValue>("256-byte values", keys);
+
+    return 0;
+}
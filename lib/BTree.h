@@ -0,0 +1,940 @@
+/*
+ * Implements a B-tree with a compile-time order.
+ *
+ * A B-tree is a self-balancing search tree whose nodes hold up to
+ * order - 1 keys and order children. It can find, insert, and delete
+ * elements in O(log n) time, and every node keeps the size of its
+ * subtree so rank and select also take O(log n) time.
+ *
+ * Wider nodes make the tree shallower, so a search touches fewer cache
+ * lines. Splits and merges happen on the way down, which needs an even
+ * order. A B-tree of order 4 is a 2-3-4 tree (see Two4Tree.h).
+*/
+
+#ifndef B_TREE_H
+#define B_TREE_H
+
+#include "Node.h"
+#include "BTreeIterator.h"
+#include "NodePool.h"
+#include "CDA.h"
+#include <string>
+#include <sstream>
+#include <array>
+#include <type_traits>
+
+template <typename keytype, typename valuetype, int order>
+class BTree {
+    private:
+        static_assert(order >= 4 && order % 2 == 0, "a B-tree needs an even order of at least 4");
+
+        static const int maxElements = order - 1;
+        static const int minElements = order / 2 - 1;
+
+        NodePool<Node<keytype, valuetype, order>> pool;
+        Node<keytype, valuetype, order>* root;
+        keytype junk;
+        Node<keytype, valuetype, order>* copySubtree(Node<keytype, valuetype, order>* oldNode);
+        void destroySubtree(Node<keytype, valuetype, order>* topNode);
+        static long long heightCapacity(int height);
+        Node<keytype, valuetype, order>* buildSubtree(keytype k[], valuetype v[], int first, int count, int height);
+        void bulkLoad(keytype k[], valuetype v[], int s);
+        Node<keytype, valuetype, order>* findNode(Node<keytype, valuetype, order>* curNode, keytype k);
+        Node<keytype, valuetype, order>* findPredecessor(Node<keytype, valuetype, order>* curNode, keytype k, int & index);
+        Node<keytype, valuetype, order>* goUpPredecessor(Node<keytype, valuetype, order>* curNode, keytype k, int & index);
+        Node<keytype, valuetype, order>* findSuccessor(Node<keytype, valuetype, order>* curNode, keytype k, int & index);
+        Node<keytype, valuetype, order>* goUpSuccessor(Node<keytype, valuetype, order>* curNode, keytype k, int & index);
+        Node<keytype, valuetype, order>* findNextChild(Node<keytype, valuetype, order>* node, keytype k);
+        void insertNonfull(Node<keytype, valuetype, order>* topNode, keytype k, valuetype v);
+        void splitChild(Node<keytype, valuetype, order>* node, int childIndex);
+        void removeUtility(Node<keytype, valuetype, order>* topNode, keytype k, keytype predecessorKey);
+        void shrink();
+        bool rotate(Node<keytype, valuetype, order>* node);
+        void merge(Node<keytype, valuetype, order>* node);
+        keytype selectUtility(Node<keytype, valuetype, order>* topNode, int pos);
+        int rankUtility(Node<keytype, valuetype, order>* curNode, keytype k, int rank);
+        void preorderStringUtility(Node<keytype, valuetype, order>* topNode, std::ostringstream & out) const;
+        void postorderStringUtility(Node<keytype, valuetype, order>* topNode, std::ostringstream & out) const;
+
+    public:
+        typedef BTreeIterator<keytype, valuetype, order> iterator;
+
+        friend void swap(BTree & tree1, BTree & tree2) {
+            using std::swap;
+            swap(tree1.pool, tree2.pool);
+            swap(tree1.root, tree2.root);
+        }
+        BTree();
+        BTree(keytype k[], valuetype V[], int s);
+        BTree(keytype k[], valuetype V[], int s, bool sorted);
+        ~BTree();
+        BTree(const BTree & oldTree);
+        BTree & operator=(BTree oldTree);
+        valuetype* search(keytype k);
+        void insert(keytype k, valuetype v);
+        int remove(keytype k);
+        int rank(keytype k);
+        keytype select(int pos);
+        keytype successor(keytype k);
+        keytype predecessor(keytype k);
+        int size() const;
+        void preorder() const;
+        void inorder() const;
+        void postorder() const;
+        std::string preorderString() const;
+        std::string inorderString() const;
+        std::string postorderString() const;
+        iterator begin() const;
+        iterator end() const;
+        iterator lower_bound(keytype k) const;
+        iterator upper_bound(keytype k) const;
+        template <typename function>
+        void rangeScan(keytype lo, keytype hi, function callback) const;
+        Node<keytype, valuetype, order>* getRoot() const;
+        const NodePool<Node<keytype, valuetype, order>> & getPool() const;
+};
+
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* BTree<keytype, valuetype, order>::findNode(Node<keytype, valuetype, order>* curNode, keytype k) {
+    while (curNode->indexOf(k) == -1) {
+        if (curNode->getNumChildren() == 0) {
+            return nullptr;
+        }
+
+        curNode = findNextChild(curNode, k);
+    }
+
+    return curNode;
+}
+
+// When you first call this function, curNode should be the node containing k.
+// Returns the node holding the predecessor and sets index to its position there.
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* BTree<keytype, valuetype, order>::findPredecessor(Node<keytype, valuetype, order>* curNode, keytype k, int & index) {
+    // The predecessor of an internal key is the largest key in its left subtree
+    if (curNode->getNumChildren() > 0) {
+        curNode = curNode->getLeftChildOf(k);
+
+        while (curNode->getNumChildren() > 0) {
+            curNode = curNode->getRightmostChild();
+        }
+
+        index = curNode->getNumElements() - 1;
+        return curNode;
+    }
+
+    else if (curNode->indexOf(k) > 0) { // There's an element in curNode smaller than k
+        index = curNode->indexOf(k) - 1;
+        return curNode;
+    }
+
+    else {
+        return goUpPredecessor(curNode, k, index);
+    }
+}
+
+// Climbs until curNode is not a leftmost child. The parent key to its left is the predecessor.
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* BTree<keytype, valuetype, order>::goUpPredecessor(Node<keytype, valuetype, order>* curNode, keytype k, int & index) {
+    while (curNode->getParent() != nullptr) {
+        if (!curNode->isLeftmostChild()) {
+            index = curNode->getParent()->indexOf(curNode) - 1;
+            return curNode->getParent();
+        }
+
+        curNode = curNode->getParent();
+    }
+
+    std::cout << "Error: key " << k << " is smallest key in tree" << std::endl;
+    Node<keytype, valuetype, order>* originalNode = findNode(root, k);
+    index = originalNode->indexOf(k);
+    return originalNode;
+}
+
+// When you first call this function, curNode should be the node containing k.
+// Returns the node holding the successor and sets index to its position there.
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* BTree<keytype, valuetype, order>::findSuccessor(Node<keytype, valuetype, order>* curNode, keytype k, int & index) {
+    // The successor of an internal key is the smallest key in its right subtree
+    if (curNode->getNumChildren() > 0) {
+        curNode = curNode->getRightChildOf(k);
+
+        while (curNode->getNumChildren() > 0) {
+            curNode = curNode->getLeftmostChild();
+        }
+
+        index = 0;
+        return curNode;
+    }
+
+    else if (curNode->indexOf(k) < curNode->getNumElements() - 1) { // There's an element in curNode greater than k
+        index = curNode->indexOf(k) + 1;
+        return curNode;
+    }
+
+    else {
+        return goUpSuccessor(curNode, k, index);
+    }
+}
+
+// Climbs until curNode is not a rightmost child. The parent key to its right is the successor.
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* BTree<keytype, valuetype, order>::goUpSuccessor(Node<keytype, valuetype, order>* curNode, keytype k, int & index) {
+    while (curNode->getParent() != nullptr) {
+        if (!curNode->isRightmostChild()) {
+            index = curNode->getParent()->indexOf(curNode);
+            return curNode->getParent();
+        }
+
+        curNode = curNode->getParent();
+    }
+
+    std::cout << "Error: key " << k << " is largest key in tree" << std::endl;
+    Node<keytype, valuetype, order>* originalNode = findNode(root, k);
+    index = originalNode->indexOf(k);
+    return originalNode;
+}
+
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* BTree<keytype, valuetype, order>::findNextChild(Node<keytype, valuetype, order>* node, keytype k) {
+    return node->getChild(node->indexOfNextChild(k));
+}
+
+// Walks down from topNode, splitting full children before entering them.
+// Every node on the path gains the new element, so its size goes up on the way down.
+template <typename keytype, typename valuetype, int order>
+void BTree<keytype, valuetype, order>::insertNonfull(Node<keytype, valuetype, order>* topNode, keytype k, valuetype v) {
+    while (topNode->getNumChildren() > 0) {
+        int childIndex = topNode->indexOfNextChild(k);
+
+        if (topNode->getChild(childIndex)->getNumElements() == maxElements) {
+            splitChild(topNode, childIndex);
+            childIndex = topNode->indexOfNextChild(k);
+        }
+
+        topNode->adjustSize(1);
+        topNode = topNode->getChild(childIndex);
+    }
+
+    topNode->insert(k, v);
+    topNode->adjustSize(1);
+}
+
+template <typename keytype, typename valuetype, int order>
+void BTree<keytype, valuetype, order>::splitChild(Node<keytype, valuetype, order>* node, int childIndex) {
+    if (node->getChild(childIndex) == nullptr) {
+        throw (std::string) "TSC1";
+    }
+
+    else if (node->getChild(childIndex)->getNumElements() != maxElements) {
+        throw (std::string) "TSC2";
+    }
+    
+    else {
+        Node<keytype, valuetype, order>* leftChild = node->getChild(childIndex);
+        Node<keytype, valuetype, order>* rightChild = pool.create();
+
+        // The median moves up, and everything after it moves to the new right child
+        int median = maxElements / 2;
+
+        node->insert(leftChild->getElement(median));
+
+        for (int i = median + 1; i < maxElements; ++i) {
+            rightChild->insert(leftChild->getElement(i));
+        }
+
+        while (leftChild->getNumElements() > median) {
+            leftChild->removeAt(median);
+        }
+
+        if (leftChild->getNumChildren() == order) {
+            // Move the rightmost subtrees over instead of copying them
+            for (int i = 0; i <= median; ++i) {
+                Node<keytype, valuetype, order>* child = leftChild->release(leftChild->getChild(median + 1));
+                rightChild->insert(child, i);
+                child->setParent(rightChild);
+            }
+        }
+
+        node->insert(rightChild, childIndex + 1);
+        rightChild->setParent(node);
+
+        leftChild->updateSize();
+        rightChild->updateSize();
+    }
+}
+
+// Walks down from topNode, topping up minimal children before entering them.
+// A node's size drops by one once nothing more will be moved into it.
+template <typename keytype, typename valuetype, int order>
+void BTree<keytype, valuetype, order>::removeUtility(Node<keytype, valuetype, order>* topNode, keytype k, keytype predecessorKey) {
+    while (topNode->getNumChildren() > 0) {
+        if (topNode->getNumElements() == 1 &&
+            topNode->getChild(0)->getNumElements() == minElements &&
+            topNode->getChild(1)->getNumElements() == minElements) {
+            shrink();
+            continue;
+        }
+
+        Node<keytype, valuetype, order>* nextChild;
+
+        if (topNode->indexOf(predecessorKey) != -1) {
+            nextChild = topNode->getLeftChildOf(predecessorKey);
+        }
+
+        else {
+            nextChild = findNextChild(topNode, k);
+        }
+
+        if (nextChild->getNumElements() == minElements) {
+            if (!rotate(nextChild)) {
+                merge(nextChild);
+            }
+
+            nextChild->updateSize();
+        }
+
+        topNode->adjustSize(-1);
+        topNode = nextChild;
+    }
+
+    topNode->remove(k);
+    topNode->adjustSize(-1);
+}
+
+template <typename keytype, typename valuetype, int order>
+void BTree<keytype, valuetype, order>::shrink() {
+    // Pull both children of a single-element root into the root
+    Node<keytype, valuetype, order>* leftChild = root->release(root->getChild(0));
+    Node<keytype, valuetype, order>* rightChild = root->release(root->getChild(0));
+
+    for (int i = 0; i < leftChild->getNumElements(); ++i) {
+        root->insert(leftChild->getElement(i));
+    }
+
+    for (int i = 0; i < rightChild->getNumElements(); ++i) {
+        root->insert(rightChild->getElement(i));
+    }
+
+    while (leftChild->getNumChildren() > 0) {
+        Node<keytype, valuetype, order>* child = leftChild->release(leftChild->getChild(0));
+        root->insert(child, root->getNumChildren());
+        child->setParent(root);
+    }
+
+    while (rightChild->getNumChildren() > 0) {
+        Node<keytype, valuetype, order>* child = rightChild->release(rightChild->getChild(0));
+        root->insert(child, root->getNumChildren());
+        child->setParent(root);
+    }
+
+    pool.destroy(leftChild);
+    pool.destroy(rightChild);
+
+    root->updateSize();
+}
+
+template <typename keytype, typename valuetype, int order>
+bool BTree<keytype, valuetype, order>::rotate(Node<keytype, valuetype, order>* node) {
+    if (node->getLeftSibling() != nullptr && node->getLeftSibling()->getNumElements() > minElements) {
+        node->insert(node->getLeftParentElement());
+        node->getParent()->setElement(node->getParent()->indexOf(node) - 1, node->getLeftSibling()->getMaximumElement());
+        node->getLeftSibling()->removeAt(node->getLeftSibling()->getNumElements() - 1);
+        
+        if (node->getLeftSibling()->getNumChildren() > 0) {
+            Node<keytype, valuetype, order>* child = node->getLeftSibling()->release(node->getLeftSibling()->getRightmostChild());
+
+            node->insert(child, 0);
+            child->setParent(node);
+        }
+
+        node->getLeftSibling()->updateSize();
+
+        return true;
+    }
+
+    else if (node->getRightSibling() != nullptr && node->getRightSibling()->getNumElements() > minElements) {
+        node->insert(node->getRightParentElement());
+        node->getParent()->setElement(node->getParent()->indexOf(node), node->getRightSibling()->getMinimumElement());
+        node->getRightSibling()->removeAt(0);
+
+        if (node->getRightSibling()->getNumChildren() > 0) {
+            Node<keytype, valuetype, order>* child = node->getRightSibling()->release(node->getRightSibling()->getLeftmostChild());
+
+            node->insert(child, node->getNumChildren());
+            child->setParent(node);
+        }
+
+        node->getRightSibling()->updateSize();
+
+        return true;
+    }
+
+    else {
+        return false;
+    }
+}
+
+template <typename keytype, typename valuetype, int order>
+void BTree<keytype, valuetype, order>::merge(Node<keytype, valuetype, order>* node) {
+    if (node->getLeftSibling() != nullptr) {
+        Node<keytype, valuetype, order>* sibling = node->getLeftSibling();
+
+        for (int i = 0; i < sibling->getNumElements(); ++i) {
+            node->insert(sibling->getElement(i));
+        }
+
+        node->insert(node->getLeftParentElement());
+
+        for (int i = 0; sibling->getNumChildren() > 0; ++i) {
+            Node<keytype, valuetype, order>* child = sibling->release(sibling->getChild(0));
+            node->insert(child, i);
+            child->setParent(node);
+        }
+
+        node->getParent()->removeAt(node->getParent()->indexOf(node) - 1);
+        pool.destroy(node->getParent()->release(sibling));
+    }
+
+    else if (node->getRightSibling() != nullptr) {
+        Node<keytype, valuetype, order>* sibling = node->getRightSibling();
+
+        for (int i = 0; i < sibling->getNumElements(); ++i) {
+            node->insert(sibling->getElement(i));
+        }
+
+        node->insert(node->getRightParentElement());
+
+        while (sibling->getNumChildren() > 0) {
+            Node<keytype, valuetype, order>* child = sibling->release(sibling->getChild(0));
+            node->insert(child, node->getNumChildren());
+            child->setParent(node);
+        }
+
+        node->getParent()->removeAt(node->getParent()->indexOf(node));
+        pool.destroy(node->getParent()->release(sibling));
+    }
+
+    else {
+        throw (std::string) "TM1";
+    }
+}
+
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* BTree<keytype, valuetype, order>::copySubtree(Node<keytype, valuetype, order>* oldNode) {
+    Node<keytype, valuetype, order>* newNode = pool.create();
+
+    for (int i = 0; i < oldNode->getNumElements(); ++i) {
+        newNode->insert(oldNode->getElement(i));
+    }
+
+    for (int i = 0; i < oldNode->getNumChildren(); ++i) {
+        Node<keytype, valuetype, order>* child = copySubtree(oldNode->getChild(i));
+        newNode->insert(child, i);
+        child->setParent(newNode);
+    }
+
+    newNode->updateSize();
+
+    return newNode;
+}
+
+template <typename keytype, typename valuetype, int order>
+void BTree<keytype, valuetype, order>::destroySubtree(Node<keytype, valuetype, order>* topNode) {
+    while (topNode->getNumChildren() > 0) {
+        destroySubtree(topNode->release(topNode->getChild(0)));
+    }
+
+    pool.destroy(topNode);
+}
+
+// Most keys a subtree of the given height can hold, counting leaves as height 0
+template <typename keytype, typename valuetype, int order>
+long long BTree<keytype, valuetype, order>::heightCapacity(int height) {
+    long long capacity = maxElements;
+
+    for (int i = 0; i < height; ++i) {
+        capacity = capacity * order + maxElements;
+    }
+
+    return capacity;
+}
+
+// Builds a subtree from the count sorted elements starting at first. A
+// node gets as few children as its keys fit in, at least two, and the
+// keys are split evenly between them. That keeps every child at least
+// half full, so the result is a valid tree with all leaves at one depth.
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* BTree<keytype, valuetype, order>::buildSubtree(keytype k[], valuetype v[], int first, int count, int height) {
+    Node<keytype, valuetype, order>* node = pool.create();
+
+    if (height == 0) {
+        for (int i = first; i < first + count; ++i) {
+            node->insert(k[i], v[i]);
+        }
+    }
+
+    else {
+        long long childCapacity = heightCapacity(height - 1);
+        int numChildren = (count + childCapacity + 1) / (childCapacity + 1);
+
+        if (numChildren < 2) {
+            numChildren = 2;
+        }
+
+        int childCount = (count - numChildren + 1) / numChildren;
+        int extra = (count - numChildren + 1) % numChildren;
+        int next = first;
+
+        for (int i = 0; i < numChildren; ++i) {
+            int curCount = (i < extra) ? childCount + 1 : childCount;
+            Node<keytype, valuetype, order>* child = buildSubtree(k, v, next, curCount, height - 1);
+            node->insert(child, i);
+            child->setParent(node);
+            next += curCount;
+
+            if (i < numChildren - 1) {
+                node->insert(k[next], v[next]);
+                ++next;
+            }
+        }
+    }
+
+    node->updateSize();
+
+    return node;
+}
+
+// Builds the tree from sorted arrays in O(n) using the fewest levels that hold s keys
+template <typename keytype, typename valuetype, int order>
+void BTree<keytype, valuetype, order>::bulkLoad(keytype k[], valuetype v[], int s) {
+    if (s == 0) {
+        root = pool.create();
+        return;
+    }
+
+    int height = 0;
+
+    while (heightCapacity(height) < s) {
+        ++height;
+    }
+
+    root = buildSubtree(k, v, 0, s, height);
+}
+
+template <typename keytype, typename valuetype, int order>
+BTree<keytype, valuetype, order>::BTree() {
+    root = pool.create();
+}
+
+template <typename keytype, typename valuetype, int order>
+BTree<keytype, valuetype, order>::BTree(keytype k[], valuetype v[], int s) {
+    root = pool.create();
+    for (int i = 0; i < s; ++i) {
+        this->insert(k[i], v[i]);
+    }
+}
+
+// Builds a packed tree bottom-up instead of inserting one element at a time.
+// If sorted is true, k must already be in ascending order. Otherwise the
+// elements are sorted first, keeping equal keys in their original order.
+template <typename keytype, typename valuetype, int order>
+BTree<keytype, valuetype, order>::BTree(keytype k[], valuetype v[], int s, bool sorted) {
+    if (sorted) {
+        bulkLoad(k, v, s);
+        return;
+    }
+
+    CDA<Element<keytype, valuetype>> elements(s);
+
+    for (int i = 0; i < s; ++i) {
+        elements[i].key = k[i];
+        elements[i].value = v[i];
+    }
+
+    // MergeSort leaves the elements in decreasing order with equal keys
+    // reversed, so reading it backwards gives a stable increasing order
+    elements.MergeSort();
+
+    keytype* sortedKeys = new keytype[s];
+    valuetype* sortedValues = new valuetype[s];
+
+    for (int i = 0; i < s; ++i) {
+        sortedKeys[i] = elements[s - 1 - i].key;
+        sortedValues[i] = elements[s - 1 - i].value;
+    }
+
+    bulkLoad(sortedKeys, sortedValues, s);
+
+    delete[] sortedKeys;
+    delete[] sortedValues;
+}
+
+template <typename keytype, typename valuetype, int order>
+BTree<keytype, valuetype, order>::~BTree() {
+    // Nodes holding plain data don't need their destructors run,
+    // so the pool can hand its slabs back without visiting them.
+    if (!std::is_trivially_destructible<Element<keytype, valuetype>>::value) {
+        destroySubtree(root);
+    }
+}
+
+template <typename keytype, typename valuetype, int order>
+BTree<keytype, valuetype, order>::BTree(const BTree<keytype, valuetype, order> & oldTree) {
+    root = copySubtree(oldTree.getRoot());
+}
+
+template <typename keytype, typename valuetype, int order>
+BTree<keytype, valuetype, order> & BTree<keytype, valuetype, order>::operator=(BTree<keytype, valuetype, order> oldTree) {
+    swap(*this, oldTree);
+    return *this;
+}
+
+template <typename keytype, typename valuetype, int order>
+valuetype* BTree<keytype, valuetype, order>::search(keytype k) {
+    Node<keytype, valuetype, order>* node = findNode(root, k);
+
+    if (node == nullptr) {
+        return nullptr;
+    }
+    
+    else {
+        valuetype* v = &(node->getValue(node->indexOf(k)));
+        return v;
+    }
+}
+
+template <typename keytype, typename valuetype, int order>
+void BTree<keytype, valuetype, order>::insert(keytype k, valuetype v) {
+    if (root->getNumElements() == maxElements) {
+        Node<keytype, valuetype, order>* newRoot = pool.create();
+        newRoot->insert(root);
+        root->setParent(newRoot);
+        root = newRoot;
+        splitChild(root, 0);
+        root->updateSize();
+    }
+
+    insertNonfull(root, k, v);
+}
+
+template <typename keytype, typename valuetype, int order>
+int BTree<keytype, valuetype, order>::remove(keytype k) {
+    Node<keytype, valuetype, order>* nodeToDelete = findNode(root, k);
+    if (nodeToDelete == nullptr) {
+        return 0;
+    }
+
+    else {
+        if (nodeToDelete->getNumChildren() > 0) {
+            int predecessorIndex;
+            Node<keytype, valuetype, order>* predecessorNode = findPredecessor(nodeToDelete, k, predecessorIndex);
+            keytype predecessorKey = predecessorNode->getKey(predecessorIndex);
+            int index = nodeToDelete->indexOf(k);
+            std::swap(nodeToDelete->getKey(index), predecessorNode->getKey(predecessorIndex));
+            std::swap(nodeToDelete->getValue(index), predecessorNode->getValue(predecessorIndex));
+            removeUtility(root, k, predecessorKey);
+        }
+
+        else {
+            removeUtility(root, k, k);
+        }
+
+        return 1;
+    }
+}
+
+template <typename keytype, typename valuetype, int order>
+int BTree<keytype, valuetype, order>::rankUtility(Node<keytype, valuetype, order>* curNode, keytype k, int rank) {
+    while (curNode->indexOf(k) == -1) {
+        if (curNode->getNumChildren() == 0) {
+            return 0;
+        }
+
+        // Everything left of the next child comes before k
+        int childIndex = curNode->indexOfNextChild(k);
+        for (int i = 0; i < childIndex; ++i) {
+            rank += curNode->getChild(i)->getSize() + 1;
+        }
+
+        curNode = curNode->getChild(childIndex);
+    }
+
+    int index = curNode->indexOf(k);
+
+    if (curNode->getNumChildren() > 0) {
+        for (int i = 0; i <= index; ++i) {
+            rank += curNode->getChild(i)->getSize();
+        }
+    }
+
+    return rank + index;
+}
+
+template <typename keytype, typename valuetype, int order>
+int BTree<keytype, valuetype, order>::rank(keytype k) {
+    int rank = 1;
+    return rankUtility(root, k, rank);
+}
+
+template <typename keytype, typename valuetype, int order>
+keytype BTree<keytype, valuetype, order>::selectUtility(Node<keytype, valuetype, order>* topNode, int pos) {
+    if (pos > topNode->getSize() || pos < 1) {
+        std::cout << "Error: pos " << pos << " is out of range" << std::endl;
+        return junk;
+    }
+
+    while (topNode->getNumChildren() > 0) {
+        int i = 0;
+
+        // Skip whole subtrees and the keys after them until pos falls inside one
+        while (pos > topNode->getChild(i)->getSize()) {
+            pos -= topNode->getChild(i)->getSize();
+
+            if (pos == 1) {
+                return topNode->getKey(i);
+            }
+
+            --pos;
+            ++i;
+
+            if (i == topNode->getNumChildren()) {
+                throw (std::string) "TSU1";
+            }
+        }
+
+        topNode = topNode->getChild(i);
+    }
+
+    return topNode->getKey(pos - 1);
+}
+
+template <typename keytype, typename valuetype, int order>
+keytype BTree<keytype, valuetype, order>::select(int pos) {
+    return selectUtility(root, pos);
+}
+
+template <typename keytype, typename valuetype, int order>
+keytype BTree<keytype, valuetype, order>::successor(keytype k) {
+    int index;
+    Node<keytype, valuetype, order>* node = findSuccessor(findNode(root, k), k, index);
+    return node->getKey(index);
+}
+
+template <typename keytype, typename valuetype, int order>
+keytype BTree<keytype, valuetype, order>::predecessor(keytype k) {
+    int index;
+    Node<keytype, valuetype, order>* node = findPredecessor(findNode(root, k), k, index);
+    return node->getKey(index);
+}
+
+template <typename keytype, typename valuetype, int order>
+int BTree<keytype, valuetype, order>::size() const {
+    return root->getSize();
+}
+
+template <typename keytype, typename valuetype, int order>
+void BTree<keytype, valuetype, order>::preorder() const {
+    std::cout << this->preorderString() << std::endl;
+}
+
+template <typename keytype, typename valuetype, int order>
+void BTree<keytype, valuetype, order>::inorder() const {
+    std::cout << this->inorderString() << std::endl;
+}
+
+template <typename keytype, typename valuetype, int order>
+void BTree<keytype, valuetype, order>::postorder() const {
+    std::cout << this->postorderString() << std::endl;
+}
+
+template <typename keytype, typename valuetype, int order>
+std::string BTree<keytype, valuetype, order>::preorderString() const {
+    std::ostringstream out;
+    preorderStringUtility(root, out);
+    std::string preorder = out.str();
+
+    if (!preorder.empty()) {
+        preorder.pop_back(); // Removes final space
+    }
+
+    return preorder;
+}
+
+template <typename keytype, typename valuetype, int order>
+std::string BTree<keytype, valuetype, order>::inorderString() const {
+    std::ostringstream out;
+
+    for (iterator it = begin(); it != end(); ++it) {
+        out << it.getKey() << ' ';
+    }
+
+    std::string inorder = out.str();
+
+    if (!inorder.empty()) {
+        inorder.pop_back(); // Removes final space
+    }
+
+    return inorder;
+}
+
+template <typename keytype, typename valuetype, int order>
+std::string BTree<keytype, valuetype, order>::postorderString() const {
+    std::ostringstream out;
+    postorderStringUtility(root, out);
+    std::string postorder = out.str();
+
+    if (!postorder.empty()) {
+        postorder.pop_back(); // Removes final space
+    }
+
+    return postorder;
+}
+
+// The traversals follow parent pointers back up instead of recursing
+template <typename keytype, typename valuetype, int order>
+void BTree<keytype, valuetype, order>::preorderStringUtility(Node<keytype, valuetype, order>* topNode, std::ostringstream & out) const {
+    Node<keytype, valuetype, order>* node = topNode;
+
+    while (true) {
+        for (int i = 0; i < node->getNumElements(); ++i) {
+            out << node->getKey(i) << ' ';
+        }
+
+        if (node->getNumChildren() > 0) {
+            node = node->getLeftmostChild();
+            continue;
+        }
+
+        // Climb to the first ancestor with an unvisited child to the right
+        while (node != topNode && node->isRightmostChild()) {
+            node = node->getParent();
+        }
+
+        if (node == topNode) {
+            return;
+        }
+
+        node = node->getRightSibling();
+    }
+}
+
+template <typename keytype, typename valuetype, int order>
+void BTree<keytype, valuetype, order>::postorderStringUtility(Node<keytype, valuetype, order>* topNode, std::ostringstream & out) const {
+    Node<keytype, valuetype, order>* node = topNode;
+
+    while (node->getNumChildren() > 0) {
+        node = node->getLeftmostChild();
+    }
+
+    while (true) {
+        for (int i = 0; i < node->getNumElements(); ++i) {
+            out << node->getKey(i) << ' ';
+        }
+
+        if (node == topNode) {
+            return;
+        }
+
+        // After the last child comes its parent, otherwise the next sibling's leftmost leaf
+        if (node->isRightmostChild()) {
+            node = node->getParent();
+        }
+
+        else {
+            node = node->getRightSibling();
+
+            while (node->getNumChildren() > 0) {
+                node = node->getLeftmostChild();
+            }
+        }
+    }
+}
+
+template <typename keytype, typename valuetype, int order>
+typename BTree<keytype, valuetype, order>::iterator BTree<keytype, valuetype, order>::begin() const {
+    if (root->getNumElements() == 0) {
+        return end();
+    }
+
+    Node<keytype, valuetype, order>* node = root;
+
+    while (node->getNumChildren() > 0) {
+        node = node->getLeftmostChild();
+    }
+
+    return iterator(root, node, 0);
+}
+
+template <typename keytype, typename valuetype, int order>
+typename BTree<keytype, valuetype, order>::iterator BTree<keytype, valuetype, order>::end() const {
+    return iterator(root, nullptr, 0);
+}
+
+// Returns the first element whose key is not less than k
+template <typename keytype, typename valuetype, int order>
+typename BTree<keytype, valuetype, order>::iterator BTree<keytype, valuetype, order>::lower_bound(keytype k) const {
+    iterator result = end();
+    Node<keytype, valuetype, order>* node = root;
+
+    while (true) {
+        int index = 0;
+
+        while (index < node->getNumElements() && node->getKey(index) < k) {
+            ++index;
+        }
+
+        // Anything smaller that still qualifies is in the child to the left of index
+        if (index < node->getNumElements()) {
+            result = iterator(root, node, index);
+        }
+
+        if (node->getNumChildren() == 0) {
+            return result;
+        }
+
+        node = node->getChild(index);
+    }
+}
+
+// Returns the first element whose key is greater than k
+template <typename keytype, typename valuetype, int order>
+typename BTree<keytype, valuetype, order>::iterator BTree<keytype, valuetype, order>::upper_bound(keytype k) const {
+    iterator result = end();
+    Node<keytype, valuetype, order>* node = root;
+
+    while (true) {
+        int index = node->indexOfNextChild(k);
+
+        if (index < node->getNumElements()) {
+            result = iterator(root, node, index);
+        }
+
+        if (node->getNumChildren() == 0) {
+            return result;
+        }
+
+        node = node->getChild(index);
+    }
+}
+
+// Calls callback(key, value) for every element with lo <= key < hi, in order
+template <typename keytype, typename valuetype, int order>
+template <typename function>
+void BTree<keytype, valuetype, order>::rangeScan(keytype lo, keytype hi, function callback) const {
+    for (iterator it = lower_bound(lo); it != end() && it.getKey() < hi; ++it) {
+        callback(it.getKey(), it.getValue());
+    }
+}
+
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* BTree<keytype, valuetype, order>::getRoot() const {
+    return root;
+}
+
+template <typename keytype, typename valuetype, int order>
+const NodePool<Node<keytype, valuetype, order>> & BTree<keytype, valuetype, order>::getPool() const {
+    return pool;
+}
+
+#endif
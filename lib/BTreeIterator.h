@@ -0,0 +1,187 @@
+/*
+ * Implements a bidirectional iterator over the elements of a B-tree.
+ *
+ * An iterator is a node and an index into its keys. It moves through
+ * the tree in sorted order by stepping down into children and back up
+ * through parent pointers, so it needs no stack and never allocates.
+ * Walking the whole tree visits every edge twice, which makes each step
+ * O(1) amortized.
+ *
+ * Dereferencing gives an Element of references to the key and value
+ * stored in the node. The key must not be changed through it.
+*/
+
+#ifndef B_TREE_ITERATOR_H
+#define B_TREE_ITERATOR_H
+
+#include "Node.h"
+#include <cstddef>
+#include <iterator>
+
+template <typename keytype, typename valuetype, int order>
+class BTreeIterator {
+    private:
+        Node<keytype, valuetype, order>* root;
+        Node<keytype, valuetype, order>* node;
+        int index;
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Element<keytype, valuetype> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Element<const keytype &, valuetype &> reference;
+        typedef void pointer;
+
+        BTreeIterator();
+        BTreeIterator(Node<keytype, valuetype, order>* root, Node<keytype, valuetype, order>* node, int index);
+        reference operator*() const;
+        BTreeIterator & operator++();
+        BTreeIterator operator++(int);
+        BTreeIterator & operator--();
+        BTreeIterator operator--(int);
+        bool operator==(const BTreeIterator & other) const;
+        bool operator!=(const BTreeIterator & other) const;
+        const keytype & getKey() const;
+        valuetype & getValue() const;
+        Node<keytype, valuetype, order>* getNode() const;
+        int getIndex() const;
+};
+
+template <typename keytype, typename valuetype, int order>
+BTreeIterator<keytype, valuetype, order>::BTreeIterator() : root(nullptr), node(nullptr), index(0) {}
+
+// A null node is the past-the-end position
+template <typename keytype, typename valuetype, int order>
+BTreeIterator<keytype, valuetype, order>::BTreeIterator(Node<keytype, valuetype, order>* root, Node<keytype, valuetype, order>* node, int index) : root(root), node(node), index(index) {}
+
+template <typename keytype, typename valuetype, int order>
+typename BTreeIterator<keytype, valuetype, order>::reference BTreeIterator<keytype, valuetype, order>::operator*() const {
+    return reference{node->getKey(index), node->getValue(index)};
+}
+
+template <typename keytype, typename valuetype, int order>
+BTreeIterator<keytype, valuetype, order> & BTreeIterator<keytype, valuetype, order>::operator++() {
+    // The next element is the leftmost one in the right subtree
+    if (node->getNumChildren() > 0) {
+        node = node->getChild(index + 1);
+
+        while (node->getNumChildren() > 0) {
+            node = node->getLeftmostChild();
+        }
+
+        index = 0;
+    }
+
+    else if (index + 1 < node->getNumElements()) {
+        ++index;
+    }
+
+    // Otherwise climb until we come up out of a child that has a key to its right
+    else {
+        while (node->getParent() != nullptr) {
+            int childIndex = node->getParent()->indexOf(node);
+            node = node->getParent();
+
+            if (childIndex < node->getNumElements()) {
+                index = childIndex;
+                return *this;
+            }
+        }
+
+        node = nullptr;
+        index = 0;
+    }
+
+    return *this;
+}
+
+template <typename keytype, typename valuetype, int order>
+BTreeIterator<keytype, valuetype, order> BTreeIterator<keytype, valuetype, order>::operator++(int) {
+    BTreeIterator<keytype, valuetype, order> old = *this;
+    ++(*this);
+    return old;
+}
+
+template <typename keytype, typename valuetype, int order>
+BTreeIterator<keytype, valuetype, order> & BTreeIterator<keytype, valuetype, order>::operator--() {
+    // Stepping back from the end lands on the largest element
+    if (node == nullptr) {
+        node = root;
+
+        while (node->getNumChildren() > 0) {
+            node = node->getRightmostChild();
+        }
+
+        index = node->getNumElements() - 1;
+    }
+
+    // The previous element is the rightmost one in the left subtree
+    else if (node->getNumChildren() > 0) {
+        node = node->getChild(index);
+
+        while (node->getNumChildren() > 0) {
+            node = node->getRightmostChild();
+        }
+
+        index = node->getNumElements() - 1;
+    }
+
+    else if (index > 0) {
+        --index;
+    }
+
+    else {
+        while (node->getParent() != nullptr) {
+            int childIndex = node->getParent()->indexOf(node);
+            node = node->getParent();
+
+            if (childIndex > 0) {
+                index = childIndex - 1;
+                return *this;
+            }
+        }
+
+        throw (std::string) "IDE1";
+    }
+
+    return *this;
+}
+
+template <typename keytype, typename valuetype, int order>
+BTreeIterator<keytype, valuetype, order> BTreeIterator<keytype, valuetype, order>::operator--(int) {
+    BTreeIterator<keytype, valuetype, order> old = *this;
+    --(*this);
+    return old;
+}
+
+template <typename keytype, typename valuetype, int order>
+bool BTreeIterator<keytype, valuetype, order>::operator==(const BTreeIterator<keytype, valuetype, order> & other) const {
+    return node == other.node && index == other.index;
+}
+
+template <typename keytype, typename valuetype, int order>
+bool BTreeIterator<keytype, valuetype, order>::operator!=(const BTreeIterator<keytype, valuetype, order> & other) const {
+    return !(*this == other);
+}
+
+template <typename keytype, typename valuetype, int order>
+const keytype & BTreeIterator<keytype, valuetype, order>::getKey() const {
+    return node->getKey(index);
+}
+
+template <typename keytype, typename valuetype, int order>
+valuetype & BTreeIterator<keytype, valuetype, order>::getValue() const {
+    return node->getValue(index);
+}
+
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* BTreeIterator<keytype, valuetype, order>::getNode() const {
+    return node;
+}
+
+template <typename keytype, typename valuetype, int order>
+int BTreeIterator<keytype, valuetype, order>::getIndex() const {
+    return index;
+}
+
+#endif
@@ -7,33 +7,366 @@
  * which only supports O(1) insertion and deletion at the back
  * of the array. A circular array can be used to implement an
  * efficient queue.
+ *
+ * The buffer is raw storage, and only the live elements in it are ever
+ * constructed. Trivially copyable elements are resized with realloc.
+ *
+ * The indexing policy decides how a logical index maps to a slot.
+ * ModuloIndexing allows any capacity. MaskIndexing rounds capacities up
+ * to powers of two and replaces the division with a mask. Either way,
+ * Segments() exposes the elements as at most two plain arrays.
+ *
+ * A GrowthPolicy sets how much the array grows when it is full and how
+ * empty it must get before it shrinks, and can be changed at runtime.
+ *
+ * MergeSort sorts with one scratch buffer and finishes short runs with
+ * insertion sort. Given more than one thread, it splits the top levels of
+ * the recursion and of the merges across a fixed set of helper threads.
+ * RadixSort sorts integers and floating point numbers in linear time, as
+ * does CountingSort for integers in a known range. CountingSortInPlace
+ * does without the second buffer.
+ *
+ * Select, Search and the sorts can split large arrays across threads.
 */
 
 #ifndef CDA_H
 #define CDA_H
 
 #include <iostream>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
-#include <ctime>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
 
+// Finds a slot with %, which works for any capacity
+struct ModuloIndexing {
+    static int RoundCapacity(int capacity) {
+        return capacity;
+    }
+
+    static int Slot(int i, int capacity) {
+        return i % capacity;
+    }
+};
+
+// Keeps the capacity a power of two so a slot can be found with a mask
+struct MaskIndexing {
+    static int RoundCapacity(int capacity) {
+        int rounded = 1;
+
+        while (rounded < capacity) {
+            rounded *= 2;
+        }
+
+        return rounded;
+    }
+
+    static int Slot(int i, int capacity) {
+        return i & (capacity - 1);
+    }
+};
+
+// A fixed set of threads that the parallel sorts, selections and searches
+// hand tasks to, so forking doesn't start a thread. ForkJoin queues its
+// first task and runs the second. ParallelFor queues all but one part of
+// a loop and runs the last. While a queued task is unfinished, the
+// forking thread runs queued tasks itself, starting with its own if no
+// helper has taken it.
+class HelperThreads {
+    private:
+        struct Task {
+            void (*run)(void*);
+            void* work;
+            std::atomic<bool> done;
+            Task* next;
+        };
+
+        std::mutex lock;
+        std::condition_variable wake;
+        Task* queued;
+        bool stopping;
+        std::thread* threads;
+        int numThreads;
+
+        void Push(Task* task) {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                task->next = queued;
+                queued = task;
+            }
+
+            wake.notify_one();
+        }
+
+        Task* TryTake() {
+            std::lock_guard<std::mutex> guard(lock);
+            Task* task = queued;
+
+            if (task != nullptr) {
+                queued = task->next;
+            }
+
+            return task;
+        }
+
+        static void Run(Task* task) {
+            task->run(task->work);
+            task->done.store(true, std::memory_order_release);
+        }
+
+        // Runs queued tasks until task is done
+        void Join(Task & task) {
+            while (!task.done.load(std::memory_order_acquire)) {
+                Task* other = TryTake();
+
+                if (other != nullptr) {
+                    Run(other);
+                }
+
+                else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        void Serve() {
+            while (true) {
+                Task* task;
+
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    wake.wait(guard, [this]() { return stopping || queued != nullptr; });
+
+                    if (queued == nullptr) {
+                        return;
+                    }
+
+                    task = queued;
+                    queued = task->next;
+                }
+
+                Run(task);
+            }
+        }
+
+    public:
+        HelperThreads(int n) : queued(nullptr), stopping(false), threads(new std::thread[n]), numThreads(n) {
+            for (int i = 0; i < n; ++i) {
+                threads[i] = std::thread([this]() { Serve(); });
+            }
+        }
+
+        ~HelperThreads() {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                stopping = true;
+            }
+
+            wake.notify_all();
+
+            for (int i = 0; i < numThreads; ++i) {
+                threads[i].join();
+            }
+
+            delete[] threads;
+        }
+
+        HelperThreads(const HelperThreads & source) = delete;
+        HelperThreads & operator=(const HelperThreads & source) = delete;
+
+        template <typename task1, typename task2>
+        void ForkJoin(task1 & first, task2 & second) {
+            Task task;
+            task.run = [](void* work) { (*static_cast<task1*>(work))(); };
+            task.work = &first;
+            task.done.store(false, std::memory_order_relaxed);
+            Push(&task);
+
+            second();
+            Join(task);
+        }
+
+        // Runs work(0) through work(count - 1)
+        template <typename task>
+        void ParallelFor(int count, task & work) {
+            struct Part {
+                task* work;
+                int index;
+            };
+
+            Task* tasks = new Task[count - 1];
+            Part* parts = new Part[count - 1];
+
+            for (int i = 0; i < count - 1; ++i) {
+                parts[i] = Part{&work, i};
+                tasks[i].run = [](void* part) { (*static_cast<Part*>(part)->work)(static_cast<Part*>(part)->index); };
+                tasks[i].work = &parts[i];
+                tasks[i].done.store(false, std::memory_order_relaxed);
+                Push(&tasks[i]);
+            }
+
+            work(count - 1);
+
+            for (int i = 0; i < count - 1; ++i) {
+                Join(tasks[i]);
+            }
+
+            delete[] tasks;
+            delete[] parts;
+        }
+};
+
+// The unsigned integer as wide as an arithmetic element, used as its radix sort key
+template <std::size_t bytes>
+struct RadixKey;
+
+template <>
+struct RadixKey<1> {
+    typedef std::uint8_t type;
+};
+
+template <>
+struct RadixKey<2> {
+    typedef std::uint16_t type;
+};
+
+template <>
+struct RadixKey<4> {
+    typedef std::uint32_t type;
+};
+
+template <>
+struct RadixKey<8> {
+    typedef std::uint64_t type;
+};
+
+// Maps e to a key that orders the same way as unsigned integers do.
+// Signed integers have their sign bit flipped. Negative floating point
+// numbers order backwards, so all their bits are flipped, and positive
+// ones just get the sign bit set.
+template <typename elmtype>
+typename RadixKey<sizeof(elmtype)>::type ToRadixKey(elmtype e) {
+    typedef typename RadixKey<sizeof(elmtype)>::type keytype;
+    const keytype signBit = static_cast<keytype>(keytype(1) << (8 * sizeof(elmtype) - 1));
+
+    keytype k;
+    std::memcpy(&k, &e, sizeof(elmtype));
+
+    if constexpr (std::is_floating_point<elmtype>::value) {
+        return (k & signBit) ? static_cast<keytype>(~k) : static_cast<keytype>(k | signBit);
+    }
+
+    else if constexpr (std::is_signed<elmtype>::value) {
+        return static_cast<keytype>(k ^ signBit);
+    }
+
+    else {
+        return k;
+    }
+}
+
 template <typename elmtype>
+elmtype FromRadixKey(typename RadixKey<sizeof(elmtype)>::type k) {
+    typedef typename RadixKey<sizeof(elmtype)>::type keytype;
+    const keytype signBit = static_cast<keytype>(keytype(1) << (8 * sizeof(elmtype) - 1));
+
+    if constexpr (std::is_floating_point<elmtype>::value) {
+        k = (k & signBit) ? static_cast<keytype>(k ^ signBit) : static_cast<keytype>(~k);
+    }
+
+    else if constexpr (std::is_signed<elmtype>::value) {
+        k = static_cast<keytype>(k ^ signBit);
+    }
+
+    elmtype e;
+    std::memcpy(&e, &k, sizeof(elmtype));
+    return e;
+}
+
+// Controls how a CDA resizes. The array grows by growthFactor when it is
+// full, and shrinks by the same factor once no more than shrinkThreshold
+// of it is in use, to no less than minimumCapacity. A sparse array below
+// that is resized up to it, so emptying a new array leaves it with
+// minimumCapacity slots. The gap between the two points stops an array
+// that hovers near one of them from resizing over and over, so
+// shrinkThreshold must be below 1 / growthFactor.
+struct GrowthPolicy {
+    double growthFactor;
+    double shrinkThreshold;
+    int minimumCapacity;
+    bool neverShrink;
+
+    GrowthPolicy() : growthFactor(2.0), shrinkThreshold(0.25), minimumCapacity(4), neverShrink(false) {}
+};
+
+template <typename elmtype, typename indexing = ModuloIndexing>
 class CDA {
+    public:
+        // The elements in order are first[0..firstLength) then second[0..secondLength)
+        struct Span {
+            elmtype* first;
+            int firstLength;
+            elmtype* second;
+            int secondLength;
+        };
+
     private:
+        static constexpr bool reallocatable = std::is_trivially_copyable<elmtype>::value && alignof(elmtype) <= alignof(std::max_align_t);
+        static const int insertionSortCutoff = 32;
+        static const int parallelCutoff = 1 << 14;
+        static const int searchBlockSize = 1 << 12;
+
         int capacity;
         int size;
         int ordered;
         int front;
         elmtype* array;
-        elmtype error;
-
-        void DoubleCapacity();
-        void HalveCapacity();
-        elmtype Quickselect(int k);
-        void Merge(CDA & array1, CDA & array2);
+        elmtype* error;
+        GrowthPolicy policy;
+        long long reallocations;
+
+        static elmtype* Allocate(int n);
+        static void Deallocate(elmtype* buffer);
+        void Reallocate(int newCapacity);
+        void Linearize();
+        void DestroyElements();
+        elmtype & Error();
+        void Grow();
+        void ShrinkIfSparse();
+        static void MultiSelect(elmtype* a, int low, int high, const int* ks, int count, int depthLimit);
+        static int HoarePartition(elmtype* a, int low, int high, int pivotIndex);
+        static int ChoosePivot(const elmtype* a, int low, int high);
+        static int MedianOfThree(const elmtype* a, int i, int j, int k);
+        static int MedianOfMedians(elmtype* a, int low, int high);
+        static void InsertionSortIncreasing(elmtype* a, int n);
+        static int DepthLimit(int n);
+        template <typename task1, typename task2>
+        static void ForkJoin(HelperThreads* helpers, bool parallel, task1 first, task2 second);
+        template <typename task>
+        static void ParallelFor(HelperThreads* helpers, int threads, task work);
+        static void SortInto(elmtype* source, elmtype* destination, int n, int threads, HelperThreads* helpers);
+        static void SortInPlace(elmtype* a, elmtype* scratch, int n, int threads, HelperThreads* helpers);
+        static void MergeRuns(elmtype* left, int leftLength, elmtype* right, int rightLength, elmtype* destination, int threads, HelperThreads* helpers);
+        static void InsertionSortRange(elmtype* a, int n);
+        int* CountKeys(int maximum, int minimum, bool increasing);
         int BinarySearch(elmtype e);
-        int LinearSearch(elmtype e);
+        int LinearSearch(elmtype e, int threads);
+        void ParallelSelect(int index, int threads);
+        void ParallelPartition(elmtype* a, elmtype* scratch, int low, int high, const elmtype & pivot, int threads, HelperThreads* helpers, int & lessEnd, int & greaterStart);
+        static int ThreadCount(int threads);
         elmtype & GetElement(int i);
+        const elmtype & GetElement(int i) const;
+        Span GetSegments() const;
+        void CheckOrderedEnd();
+        void CheckOrderedFront();
 
     public:
         friend void swap(CDA & c1, CDA & c2) {
@@ -44,60 +377,96 @@ class CDA {
             swap(c1.front, c2.front);
             swap(c1.array, c2.array);
             swap(c1.error, c2.error);
+            swap(c1.policy, c2.policy);
+            swap(c1.reallocations, c2.reallocations);
         }
 
         CDA();
         CDA(int s);
         CDA(const CDA & source);
+        CDA(CDA && source) noexcept;
         CDA & operator =(CDA source);
         ~CDA();
         elmtype & operator[](int i);
-        void AddEnd(elmtype v);
-        void AddFront(elmtype v);
+        void AddEnd(const elmtype & v);
+        void AddEnd(elmtype && v);
+        void AddFront(const elmtype & v);
+        void AddFront(elmtype && v);
+        template <typename... argtypes>
+        elmtype & EmplaceEnd(argtypes&&... args);
+        template <typename... argtypes>
+        elmtype & EmplaceFront(argtypes&&... args);
         void DelEnd();
         void DelFront();
         int Length();
         int EmptySlots();
         void Clear();
+        void Reserve(int n);
+        void ShrinkToFit();
+        Span Segments();
+        void SetGrowthPolicy(const GrowthPolicy & newPolicy);
+        GrowthPolicy GetGrowthPolicy();
+        long long Reallocations();
         int Ordered();
         int SetOrdered();
-        elmtype Select(int k);
+        elmtype Select(int k, int threads = 1);
+        void SelectMany(const int ks[], int count, elmtype results[]);
         void InsertionSort();
-        void MergeSort();
-        void CountingSort(int m);
-        int Search(elmtype e);
+        void MergeSort(int threads = 1);
+        void CountingSort(int maximum, int minimum = 0, bool increasing = false);
+        void CountingSortInPlace(int maximum, int minimum = 0, bool increasing = false);
+        void RadixSort(bool increasing = false, int threads = 1, int digitBits = 0);
+        int Search(elmtype e, int threads = 1);
 };
 
-template <typename elmtype>
-CDA<elmtype>::CDA() : capacity(1), size(0), ordered(0), front(0), array(new elmtype[capacity]) {}
+template <typename elmtype, typename indexing>
+CDA<elmtype, indexing>::CDA() : capacity(1), size(0), ordered(0), front(0), array(Allocate(capacity)), error(nullptr), reallocations(0) {}
 
-template <typename elmtype>
-CDA<elmtype>::CDA(int s) : capacity(s), size(s), ordered(0), front(0), array(new elmtype[capacity]) {}
+// Makes an array of s default-initialized elements
+template <typename elmtype, typename indexing>
+CDA<elmtype, indexing>::CDA(int s) : capacity(indexing::RoundCapacity(s)), size(s), ordered(0), front(0), array(Allocate(capacity)), error(nullptr), reallocations(0) {
+    for (int i = 0; i < size; ++i) {
+        new (array + i) elmtype;
+    }
+}
 
-template <typename elmtype>
-CDA<elmtype>::CDA(const CDA & source) : capacity(source.capacity), size(source.size), ordered(source.ordered), front(source.front), array(new elmtype[capacity]) {
+template <typename elmtype, typename indexing>
+CDA<elmtype, indexing>::CDA(const CDA & source) : capacity(source.capacity), size(source.size), ordered(source.ordered), front(0), array(Allocate(capacity)), error(nullptr), policy(source.policy), reallocations(0) {
     for (int i = 0; i < size; ++i) {
-        array[i] = source.array[i];
+        new (array + i) elmtype(source.GetElement(i));
     }
 }
 
-template <typename elmtype>
-CDA<elmtype> & CDA<elmtype>::operator =(CDA<elmtype> source) {
+// Takes over the source's buffer. The source is left empty with no
+// buffer, and allocates a new one the next time something is added.
+template <typename elmtype, typename indexing>
+CDA<elmtype, indexing>::CDA(CDA && source) noexcept : capacity(source.capacity), size(source.size), ordered(source.ordered), front(source.front), array(source.array), error(nullptr), policy(source.policy), reallocations(source.reallocations) {
+    source.capacity = 0;
+    source.size = 0;
+    source.ordered = 0;
+    source.front = 0;
+    source.array = nullptr;
+}
+
+template <typename elmtype, typename indexing>
+CDA<elmtype, indexing> & CDA<elmtype, indexing>::operator =(CDA<elmtype, indexing> source) {
     swap(*this, source);
     return *this;
 }
 
-template <typename elmtype>
-CDA<elmtype>::~CDA() {
-    delete[] array;
+template <typename elmtype, typename indexing>
+CDA<elmtype, indexing>::~CDA() {
+    DestroyElements();
+    Deallocate(array);
+    delete error;
 }
 
-template <typename elmtype>
-elmtype & CDA<elmtype>::operator[](int i) {
+template <typename elmtype, typename indexing>
+elmtype & CDA<elmtype, indexing>::operator[](int i) {
     ordered = 0;
     if (i < 0 || i >= size) {
         std::cout << "ERROR: out of bounds" << std::endl;
-        return error;
+        return Error();
     }
 
     else {
@@ -105,116 +474,173 @@ elmtype & CDA<elmtype>::operator[](int i) {
     }
 }
 
-template <typename elmtype>
-void CDA<elmtype>::AddEnd(elmtype v) {
-    if (size == capacity) {
-        DoubleCapacity();
-    }
-
-    GetElement(size) = v;
-    ++size;
-
-    // Check if array is still ordered
-    if (ordered == 1 && GetElement(size - 2) > GetElement(size - 1)) {
-        if (size == 2) {
-            ordered = -1;
-        }
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::AddEnd(const elmtype & v) {
+    EmplaceEnd(v);
+}
 
-        else {
-            ordered = 0;
-        }
-    }
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::AddEnd(elmtype && v) {
+    EmplaceEnd(std::move(v));
+}
 
-    else if (ordered == -1 && GetElement(size - 2) < GetElement(size - 1)) {
-        if (size == 2) {
-            ordered = 1;
-        }
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::AddFront(const elmtype & v) {
+    EmplaceFront(v);
+}
 
-        else {
-            ordered = 0;
-        }
-    }
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::AddFront(elmtype && v) {
+    EmplaceFront(std::move(v));
 }
 
-template <typename elmtype>
-void CDA<elmtype>::AddFront(elmtype v) {
+// Builds the new last element from args and returns it
+template <typename elmtype, typename indexing>
+template <typename... argtypes>
+elmtype & CDA<elmtype, indexing>::EmplaceEnd(argtypes&&... args) {
     if (size == capacity) {
-        DoubleCapacity();
+        // Build the element before growing, since args may refer into the array
+        elmtype element(std::forward<argtypes>(args)...);
+        Grow();
+        new (&GetElement(size)) elmtype(std::move(element));
     }
 
-    front = (front - 1 + capacity) % capacity;
-    GetElement(0) = v;
+    else {
+        new (&GetElement(size)) elmtype(std::forward<argtypes>(args)...);
+    }
 
     ++size;
 
-    // Check if array is still ordered
-    if (ordered == 1 && GetElement(0) > GetElement(1)) {
-        if (size == 2) {
-            ordered = -1;
-        }
+    CheckOrderedEnd();
 
-        else {
-            ordered = 0;
-        }
-    }
+    return GetElement(size - 1);
+}
 
-    else if (ordered == -1 && GetElement(0) < GetElement(1)) {
-        if (size == 2) {
-            ordered = 1;
-        }
+// Builds the new first element from args and returns it
+template <typename elmtype, typename indexing>
+template <typename... argtypes>
+elmtype & CDA<elmtype, indexing>::EmplaceFront(argtypes&&... args) {
+    if (size == capacity) {
+        elmtype element(std::forward<argtypes>(args)...);
+        Grow();
+        front = indexing::Slot(front - 1 + capacity, capacity);
+        new (&GetElement(0)) elmtype(std::move(element));
+    }
 
-        else {
-            ordered = 0;
-        }
+    else {
+        front = indexing::Slot(front - 1 + capacity, capacity);
+        new (&GetElement(0)) elmtype(std::forward<argtypes>(args)...);
     }
+
+    ++size;
+
+    CheckOrderedFront();
+
+    return GetElement(0);
 }
 
-template <typename elmtype>
-void CDA<elmtype>::DelEnd() {
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::DelEnd() {
+    GetElement(size - 1).~elmtype();
     --size;
 
-    if (size <= capacity / 4.0) {
-        HalveCapacity();
-    }
+    ShrinkIfSparse();
 }
 
-template <typename elmtype>
-void CDA<elmtype>::DelFront() {
-    front = (front + 1) % capacity;
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::DelFront() {
+    GetElement(0).~elmtype();
+    front = indexing::Slot(front + 1, capacity);
     --size;
 
-    if (size <= capacity / 4.0) {
-        HalveCapacity();
-    }
+    ShrinkIfSparse();
 }
 
-template <typename elmtype>
-int CDA<elmtype>::Length() {
+template <typename elmtype, typename indexing>
+int CDA<elmtype, indexing>::Length() {
     return size;
 }
 
-template <typename elmtype>
-int CDA<elmtype>::EmptySlots() {
+template <typename elmtype, typename indexing>
+int CDA<elmtype, indexing>::EmptySlots() {
     return capacity - size;
 }
 
-template <typename elmtype>
-void CDA<elmtype>::Clear() {
-    delete[] array;
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::Clear() {
+    DestroyElements();
+    Deallocate(array);
     capacity = 1;
     size = 0;
     ordered = 0;
     front = 0;
-    array = new elmtype[capacity];
+    array = Allocate(capacity);
 }
 
-template <typename elmtype>
-int CDA<elmtype>::Ordered() {
+// Makes room for at least n elements without changing the contents
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::Reserve(int n) {
+    if (n > capacity) {
+        Reallocate(n);
+    }
+}
+
+// Gives back every unused slot
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::ShrinkToFit() {
+    int newCapacity = (size > 0) ? size : 1;
+
+    if (newCapacity < capacity) {
+        Reallocate(newCapacity);
+    }
+}
+
+// Gives direct access to the elements. Like operator[], this forgets
+// whether the array is ordered, since the elements can be changed.
+template <typename elmtype, typename indexing>
+typename CDA<elmtype, indexing>::Span CDA<elmtype, indexing>::Segments() {
+    ordered = 0;
+    return GetSegments();
+}
+
+// Throws if the policy could never shrink or would resize back and forth
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::SetGrowthPolicy(const GrowthPolicy & newPolicy) {
+    if (newPolicy.growthFactor <= 1.0) {
+        throw (std::string) "CSG1";
+    }
+
+    else if (newPolicy.shrinkThreshold < 0.0 || newPolicy.shrinkThreshold * newPolicy.growthFactor >= 1.0) {
+        throw (std::string) "CSG2";
+    }
+
+    else if (newPolicy.minimumCapacity < 1) {
+        throw (std::string) "CSG3";
+    }
+
+    else {
+        policy = newPolicy;
+    }
+}
+
+template <typename elmtype, typename indexing>
+GrowthPolicy CDA<elmtype, indexing>::GetGrowthPolicy() {
+    return policy;
+}
+
+// Number of times the buffer has been resized
+template <typename elmtype, typename indexing>
+long long CDA<elmtype, indexing>::Reallocations() {
+    return reallocations;
+}
+
+template <typename elmtype, typename indexing>
+int CDA<elmtype, indexing>::Ordered() {
     return ordered;
 }
 
-template <typename elmtype>
-int CDA<elmtype>::SetOrdered() {
+template <typename elmtype, typename indexing>
+int CDA<elmtype, indexing>::SetOrdered() {
     if (size <= 1) {
         ordered = 0;
     }
@@ -250,9 +676,18 @@ int CDA<elmtype>::SetOrdered() {
 
 // Find the k-th smallest element in the array without sorting.
 // If the array is already sorted, this takes O(1) time.
-// If the array is unsorted, this takes O(n) time on average.
-template <typename elmtype>
-elmtype CDA<elmtype>::Select(int k) {
+// If the array is unsorted, this takes O(n) time in the worst case, and
+// reorders the array in place so that the k-th smallest element sits at
+// index k - 1 with nothing larger before it and nothing smaller after it.
+// Large unsorted arrays are partitioned by threads threads, or one per
+// core if threads is 0.
+template <typename elmtype, typename indexing>
+elmtype CDA<elmtype, indexing>::Select(int k, int threads) {
+    if (k < 1 || k > size) {
+        std::cout << "ERROR: out of bounds" << std::endl;
+        return Error();
+    }
+
     if (ordered == 1) {
         return GetElement(k - 1);
     }
@@ -262,199 +697,1010 @@ elmtype CDA<elmtype>::Select(int k) {
     }
 
     else {
-        return Quickselect(k);
+        Linearize();
+        ParallelSelect(k - 1, ThreadCount(threads));
+        return array[front + k - 1];
     }
 }
 
-template <typename elmtype>
-void CDA<elmtype>::InsertionSort() {
+// Finds the ks[i]-th smallest element for each of the count ranks in ks and
+// stores it in results[i]. One pass of partitioning serves every rank, so
+// this is cheaper than calling Select for each one. Reorders an unsorted
+// array the same way Select does, for every rank at once.
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::SelectMany(const int ks[], int count, elmtype results[]) {
+    for (int i = 0; i < count; ++i) {
+        if (ks[i] < 1 || ks[i] > size) {
+            throw (std::string) "CSM1";
+        }
+    }
+
+    if (ordered == 0 && count > 0) {
+        // MultiSelect wants the ranks as sorted indexes
+        int* indexes = new int[count];
+
+        for (int i = 0; i < count; ++i) {
+            int index = ks[i] - 1;
+            int j;
+
+            for (j = i - 1; j >= 0 && indexes[j] > index; --j) {
+                indexes[j + 1] = indexes[j];
+            }
+
+            indexes[j + 1] = index;
+        }
+
+        Linearize();
+        MultiSelect(array + front, 0, size, indexes, count, DepthLimit(size));
+        delete[] indexes;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        if (ordered == -1) {
+            results[i] = GetElement(size - ks[i]);
+        }
+
+        else {
+            results[i] = GetElement(ks[i] - 1);
+        }
+    }
+}
+
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::InsertionSort() {
     for (int i = 1; i < size; ++i) {
-        elmtype key = GetElement(i);
+        elmtype key = std::move(GetElement(i));
         int j;
 
         for (j = i - 1; j >= 0 && key > GetElement(j); --j) {
-            GetElement(j + 1) = GetElement(j);
+            GetElement(j + 1) = std::move(GetElement(j));
         }
 
-        GetElement(j + 1) = key;
+        GetElement(j + 1) = std::move(key);
     }
 
     ordered = -1;
 }
 
-template <typename elmtype>
-void CDA<elmtype>::MergeSort() {
+// Sorts the array in decreasing order, leaving equal elements in the
+// reverse of their original order. Uses up to threads threads, or one per
+// core if threads is 0. Large arrays sorted with more than one thread
+// start threads - 1 helper threads for the length of the sort.
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::MergeSort(int threads) {
+    threads = ThreadCount(threads);
+
     if (size > 1) {
-        int size1 = size / 2;
-        int size2 = size / 2.0 + 0.5;
-        
-        CDA array1(size1);
-        CDA array2(size2);
+        HelperThreads* helpers = (threads > 1 && size >= parallelCutoff) ? new HelperThreads(threads - 1) : nullptr;
+        Linearize();
 
-        for (int i = 0; i < size1; ++i) {
-            array1[i] = GetElement(i);
-        }
+        // The scratch buffer starts out holding the elements, and the
+        // sort moves them back into the array in order
+        elmtype* scratch = Allocate(size);
 
-        for (int i = 0; i < size2; ++i) {
-            array2[i] = GetElement(i + array1.Length());
+        for (int i = 0; i < size; ++i) {
+            new (scratch + i) elmtype(std::move(array[front + i]));
         }
 
-        array1.MergeSort();
-        array2.MergeSort();
+        SortInto(scratch, array + front, size, threads, helpers);
+
+        for (int i = 0; i < size; ++i) {
+            scratch[i].~elmtype();
+        }
 
-        Merge(array1, array2);
+        Deallocate(scratch);
+        delete helpers;
     }
 
-    front = 0;
     ordered = -1;
 }
 
-template <typename elmtype>
-void CDA<elmtype>::CountingSort(int m) {
-    int count[m + 1];
-
-    for (int i = 0; i < m + 1; ++i) {
-        count[i] = 0;
-    }
+// Sorts elements whose values lie between minimum and maximum in
+// O(n + maximum - minimum) time, in decreasing order unless increasing is
+// set. Equal elements keep their order. The sorted elements go into a new
+// buffer, so use CountingSortInPlace when memory is tight.
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::CountingSort(int maximum, int minimum, bool increasing) {
+    int* count = CountKeys(maximum, minimum, increasing);
+    long long range = (long long) maximum - minimum + 1;
 
-    for (int i = 0; i < size; ++i) {
-        ++count[m - GetElement(i)];
-    }
-    
     int total = 0;
-    for (int i = 0; i <= m; ++i) {
+    for (long long i = 0; i < range; ++i) {
         int temp = count[i];
         count[i] = total;
         total += temp;
     }
 
-    elmtype* sortedArray = new elmtype[capacity];
-    for (int i = 0; i < size; ++i) {
-        sortedArray[count[m - GetElement(i)]] = GetElement(i);
-        ++count[m - GetElement(i)];
+    elmtype* sortedArray = Allocate(capacity);
+    Span span = GetSegments();
+
+    for (int i = 0; i < span.firstLength; ++i) {
+        int key = increasing ? span.first[i] - minimum : maximum - span.first[i];
+        new (sortedArray + count[key]++) elmtype(span.first[i]);
     }
 
-    delete[] array;
+    for (int i = 0; i < span.secondLength; ++i) {
+        int key = increasing ? span.second[i] - minimum : maximum - span.second[i];
+        new (sortedArray + count[key]++) elmtype(span.second[i]);
+    }
+
+    delete[] count;
+
+    DestroyElements();
+    Deallocate(array);
     array = sortedArray;
 
     front = 0;
-    ordered = -1;
+    ordered = increasing ? 1 : -1;
 }
 
-template <typename elmtype>
-int CDA<elmtype>::Search(elmtype e) {
-    if (ordered == 1 || ordered == -1) {
-        return BinarySearch(e);
+// Same as CountingSort, but swaps the elements into place (American flag
+// sort) instead of copying them into a second buffer. Equal elements may
+// change order.
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::CountingSortInPlace(int maximum, int minimum, bool increasing) {
+    int* next = CountKeys(maximum, minimum, increasing);
+    long long range = (long long) maximum - minimum + 1;
+    int* end = new int[range];
+
+    // next[key] is the first unfilled slot of the key's bucket, and
+    // end[key] is one past its last slot
+    int total = 0;
+    for (long long i = 0; i < range; ++i) {
+        total += next[i];
+        end[i] = total;
+        next[i] = total - next[i];
     }
 
-    else {
-        return LinearSearch(e);
-    }
-}
+    Span span = GetSegments();
+    auto at = [&span](int i) -> elmtype & {
+        return (i < span.firstLength) ? span.first[i] : span.second[i - span.firstLength];
+    };
 
-template <typename elmtype>
-void CDA<elmtype>::DoubleCapacity() {
-    int newCapacity = capacity * 2;
-    elmtype* newArray = new elmtype[newCapacity];
+    // Fill the buckets in order. Each swap puts one element in its bucket
+    // for good, so this takes O(n) swaps in all.
+    for (long long bucket = 0; bucket < range; ++bucket) {
+        while (next[bucket] < end[bucket]) {
+            elmtype & e = at(next[bucket]);
+            int key = increasing ? e - minimum : maximum - e;
 
-    for (int i = 0; i < size; ++i) {
-        newArray[i] = GetElement(i);
+            if (key == bucket) {
+                ++next[bucket];
+            }
+
+            else {
+                using std::swap;
+                swap(e, at(next[key]++));
+            }
+        }
     }
 
-    delete[] array;
+    delete[] next;
+    delete[] end;
 
-    capacity = newCapacity;
-    front = 0;
-    array = newArray;
+    ordered = increasing ? 1 : -1;
 }
 
-template <typename elmtype>
-void CDA<elmtype>::HalveCapacity() {
-    int newCapacity = capacity / 2.0 + 0.5;
+// Sorts integral, float or double elements with a least significant digit
+// radix sort, in decreasing order unless increasing is set. Equal elements
+// keep their order. Each pass sorts on digitBits bits, from 1 to 16, or on
+// a width picked from the element size if digitBits is 0. Arrays big
+// enough to be worth it have each pass split across threads threads, or
+// one per core if threads is 0.
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::RadixSort(bool increasing, int threads, int digitBits) {
+    static_assert(std::is_integral<elmtype>::value || std::is_same<elmtype, float>::value || std::is_same<elmtype, double>::value, "RadixSort needs integral, float or double elements");
+    typedef typename RadixKey<sizeof(elmtype)>::type keytype;
+    const int keyBits = 8 * sizeof(elmtype);
+
+    // 8-bit digits for small types, three 11-bit passes for 32-bit types
+    // and four 16-bit passes for 64-bit types
+    if (digitBits == 0) {
+        digitBits = (keyBits <= 16) ? 8 : (keyBits == 32) ? 11 : 16;
+    }
 
-    if (newCapacity < 4) {
-        newCapacity = 4;
+    if (digitBits < 1 || digitBits > 16) {
+        throw (std::string) "CRS1";
     }
 
-    elmtype* newArray = new elmtype[newCapacity];
+    threads = (size < parallelCutoff) ? 1 : ThreadCount(threads);
 
-    for (int i = 0; i < size; ++i) {
-        newArray[i] = GetElement(i);
+    // One set of helpers serves every pass
+    HelperThreads* helpers = (threads > 1) ? new HelperThreads(threads - 1) : nullptr;
+    const int buckets = 1 << digitBits;
+    keytype* keys = new keytype[size];
+    keytype* sorted = new keytype[size];
+    int* counts = new int[threads * buckets];
+    int chunkSize = (size + threads - 1) / threads;
+
+    // Sorting the complements increasingly sorts the keys decreasingly
+    Span span = GetSegments();
+
+    for (int i = 0; i < span.firstLength; ++i) {
+        keys[i] = increasing ? ToRadixKey(span.first[i]) : static_cast<keytype>(~ToRadixKey(span.first[i]));
+    }
+
+    for (int i = 0; i < span.secondLength; ++i) {
+        keys[span.firstLength + i] = increasing ? ToRadixKey(span.second[i]) : static_cast<keytype>(~ToRadixKey(span.second[i]));
+    }
+
+    for (int shift = 0; shift < keyBits; shift += digitBits) {
+        // Each thread counts the digits in its own chunk
+        ParallelFor(helpers, threads, [&](int t) {
+            int* count = counts + t * buckets;
+            int end = (t + 1) * chunkSize < size ? (t + 1) * chunkSize : size;
+
+            for (int b = 0; b < buckets; ++b) {
+                count[b] = 0;
+            }
+
+            for (int i = t * chunkSize; i < end; ++i) {
+                ++count[(keys[i] >> shift) & (buckets - 1)];
+            }
+        });
+
+        // Turn the counts into starting offsets. Within a bucket, each
+        // thread's elements go after those of the threads before it.
+        int total = 0;
+        bool oneBucket = false;
+
+        for (int b = 0; b < buckets; ++b) {
+            int bucketStart = total;
+
+            for (int t = 0; t < threads; ++t) {
+                int count = counts[t * buckets + b];
+                counts[t * buckets + b] = total;
+                total += count;
+            }
+
+            if (total - bucketStart == size) {
+                oneBucket = true;
+            }
+        }
+
+        // Every key has the same digit here, so the pass would change nothing
+        if (oneBucket) {
+            continue;
+        }
+
+        ParallelFor(helpers, threads, [&](int t) {
+            int* offset = counts + t * buckets;
+            int end = (t + 1) * chunkSize < size ? (t + 1) * chunkSize : size;
+
+            for (int i = t * chunkSize; i < end; ++i) {
+                sorted[offset[(keys[i] >> shift) & (buckets - 1)]++] = keys[i];
+            }
+        });
+
+        std::swap(keys, sorted);
+    }
+
+    for (int i = 0; i < span.firstLength; ++i) {
+        keytype k = keys[i];
+        span.first[i] = FromRadixKey<elmtype>(increasing ? k : static_cast<keytype>(~k));
+    }
+
+    for (int i = 0; i < span.secondLength; ++i) {
+        keytype k = keys[span.firstLength + i];
+        span.second[i] = FromRadixKey<elmtype>(increasing ? k : static_cast<keytype>(~k));
+    }
+
+    delete[] keys;
+    delete[] sorted;
+    delete[] counts;
+    delete helpers;
+
+    ordered = increasing ? 1 : -1;
+}
+
+// Unsorted arrays are scanned by threads threads, or one per core if
+// threads is 0, and the first match is returned either way
+template <typename elmtype, typename indexing>
+int CDA<elmtype, indexing>::Search(elmtype e, int threads) {
+    if (ordered == 1 || ordered == -1) {
+        return BinarySearch(e);
+    }
+
+    else {
+        return LinearSearch(e, ThreadCount(threads));
+    }
+}
+
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::Grow() {
+    int newCapacity = capacity * policy.growthFactor;
+
+    if (newCapacity <= capacity) {
+        newCapacity = capacity + 1;
+    }
+
+    Reallocate(newCapacity);
+}
+
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::ShrinkIfSparse() {
+    if (policy.neverShrink || size > capacity * policy.shrinkThreshold) {
+        return;
+    }
+
+    int newCapacity = capacity / policy.growthFactor + 0.5;
+
+    if (newCapacity < policy.minimumCapacity) {
+        newCapacity = policy.minimumCapacity;
+    }
+
+    if (newCapacity < size) {
+        newCapacity = size;
+    }
+
+    Reallocate(newCapacity);
+}
+
+template <typename elmtype, typename indexing>
+elmtype* CDA<elmtype, indexing>::Allocate(int n) {
+    if (n == 0) {
+        return nullptr;
+    }
+
+    if constexpr (reallocatable) {
+        void* buffer = std::malloc(n * sizeof(elmtype));
+
+        if (buffer == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<elmtype*>(buffer);
+    }
+
+    else {
+        return static_cast<elmtype*>(::operator new(n * sizeof(elmtype), std::align_val_t(alignof(elmtype))));
+    }
+}
+
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::Deallocate(elmtype* buffer) {
+    if constexpr (reallocatable) {
+        std::free(buffer);
+    }
+
+    else if (buffer != nullptr) {
+        ::operator delete(buffer, std::align_val_t(alignof(elmtype)));
+    }
+}
+
+// Moves the live elements into a buffer with room for newCapacity of them
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::Reallocate(int newCapacity) {
+    newCapacity = indexing::RoundCapacity(newCapacity);
+
+    if (newCapacity == capacity) {
+        return;
     }
 
-    delete[] array;
+    ++reallocations;
+
+    // Number of live elements that wrapped around to the start of the buffer
+    int wrapped = front + size - capacity;
+
+    if constexpr (reallocatable) {
+        // Growing keeps front where it is. Anything that wrapped
+        // around moves to the slots just past the old end.
+        if (array != nullptr && newCapacity > capacity && capacity + wrapped <= newCapacity) {
+            void* buffer = std::realloc(array, newCapacity * sizeof(elmtype));
+
+            if (buffer == nullptr) {
+                throw std::bad_alloc();
+            }
+
+            array = static_cast<elmtype*>(buffer);
+
+            if (wrapped > 0) {
+                std::memcpy(array + capacity, array, wrapped * sizeof(elmtype));
+            }
+
+            capacity = newCapacity;
+            return;
+        }
+
+        // Shrinking slides the elements down to slot 0 first
+        else if (array != nullptr && newCapacity < capacity && wrapped <= 0) {
+            if (front != 0) {
+                std::memmove(array, array + front, size * sizeof(elmtype));
+            }
+
+            void* buffer = std::realloc(array, newCapacity * sizeof(elmtype));
+
+            if (buffer == nullptr) {
+                throw std::bad_alloc();
+            }
+
+            array = static_cast<elmtype*>(buffer);
+            capacity = newCapacity;
+            front = 0;
+            return;
+        }
+    }
+
+    elmtype* newArray = Allocate(newCapacity);
+
+    for (int i = 0; i < size; ++i) {
+        new (newArray + i) elmtype(std::move(GetElement(i)));
+        GetElement(i).~elmtype();
+    }
+
+    Deallocate(array);
 
     capacity = newCapacity;
     front = 0;
     array = newArray;
 }
 
-template <typename elmtype>
-elmtype CDA<elmtype>::Quickselect(int k) {
-    srand(time(NULL));
-    elmtype pivot = GetElement(rand() % size);
+// Moves the elements into a new buffer of the same size if they wrap
+// around the end of this one, so they sit in a single run
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::Linearize() {
+    if (front + size <= capacity) {
+        return;
+    }
 
-    CDA less;
-    CDA greater;
-    CDA equal;
+    elmtype* newArray = Allocate(capacity);
 
     for (int i = 0; i < size; ++i) {
-        if (GetElement(i) < pivot) {
-            less.AddEnd(GetElement(i));
+        new (newArray + i) elmtype(std::move(GetElement(i)));
+        GetElement(i).~elmtype();
+    }
+
+    Deallocate(array);
+
+    front = 0;
+    array = newArray;
+}
+
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::DestroyElements() {
+    if (!std::is_trivially_destructible<elmtype>::value) {
+        Span span = GetSegments();
+
+        for (int i = 0; i < span.firstLength; ++i) {
+            span.first[i].~elmtype();
+        }
+
+        for (int i = 0; i < span.secondLength; ++i) {
+            span.second[i].~elmtype();
+        }
+    }
+}
+
+// The element handed out for out of bounds accesses. It is only made the
+// first time it is needed, so elmtype needs no default constructor otherwise.
+template <typename elmtype, typename indexing>
+elmtype & CDA<elmtype, indexing>::Error() {
+    if constexpr (std::is_default_constructible<elmtype>::value) {
+        if (error == nullptr) {
+            error = new elmtype();
+        }
+
+        return *error;
+    }
+
+    else {
+        throw (std::string) "CDE1";
+    }
+}
+
+// Moves the element of rank index into place in the linearized array.
+// While the range left is large, each round partitions it three ways in
+// parallel and keeps the part holding index. Small ranges, and ranges
+// where the pivots keep coming out badly, are left to MultiSelect.
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::ParallelSelect(int index, int threads) {
+    elmtype* a = array + front;
+    int low = 0;
+    int high = size;
+    int rounds = DepthLimit(size);
+
+    if (threads > 1 && size >= parallelCutoff) {
+        HelperThreads* helpers = new HelperThreads(threads - 1);
+        elmtype* scratch = Allocate(size);
+
+        while (high - low >= parallelCutoff && rounds-- > 0) {
+            elmtype pivot = a[ChoosePivot(a, low, high)];
+            int lessEnd;
+            int greaterStart;
+            ParallelPartition(a, scratch, low, high, pivot, threads, helpers, lessEnd, greaterStart);
+
+            if (index < lessEnd) {
+                high = lessEnd;
+            }
+
+            else if (index >= greaterStart) {
+                low = greaterStart;
+            }
+
+            // Only elements equal to the pivot are left
+            else {
+                low = high;
+            }
         }
 
-        else if (GetElement(i) == pivot) {
-            equal.AddEnd(GetElement(i));
+        Deallocate(scratch);
+        delete helpers;
+    }
+
+    if (low < high) {
+        MultiSelect(a, low, high, &index, 1, DepthLimit(high - low));
+    }
+}
+
+// Splits a[low..high) into the elements less than, equal to and greater
+// than pivot, in that order. Each thread counts its own block, the counts
+// give every thread its own place to write to in each part, and then
+// each thread moves its block into scratch and back. Sets lessEnd and
+// greaterStart to where the equal part begins and ends.
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::ParallelPartition(elmtype* a, elmtype* scratch, int low, int high, const elmtype & pivot, int threads, HelperThreads* helpers, int & lessEnd, int & greaterStart) {
+    int blockSize = (high - low + threads - 1) / threads;
+    int* less = new int[threads];
+    int* greater = new int[threads];
+
+    auto blockStart = [=](int t) {
+        return (high - low <= t * blockSize) ? high : low + t * blockSize;
+    };
+
+    ParallelFor(helpers, threads, [&](int t) {
+        int start = blockStart(t);
+        int end = blockStart(t + 1);
+        less[t] = 0;
+        greater[t] = 0;
+
+        for (int i = start; i < end; ++i) {
+            if (a[i] < pivot) {
+                ++less[t];
+            }
+
+            else if (pivot < a[i]) {
+                ++greater[t];
+            }
+        }
+    });
+
+    int totalLess = 0;
+    int totalGreater = 0;
+
+    for (int t = 0; t < threads; ++t) {
+        totalLess += less[t];
+        totalGreater += greater[t];
+    }
+
+    lessEnd = low + totalLess;
+    greaterStart = high - totalGreater;
+
+    ParallelFor(helpers, threads, [&](int t) {
+        int start = blockStart(t);
+        int end = blockStart(t + 1);
+
+        // Where this thread's share of each part starts
+        int nextLess = low;
+        int nextEqual = lessEnd;
+        int nextGreater = greaterStart;
+
+        for (int u = 0; u < t; ++u) {
+            nextLess += less[u];
+            nextGreater += greater[u];
+            nextEqual += blockStart(u + 1) - blockStart(u) - less[u] - greater[u];
+        }
+
+        for (int i = start; i < end; ++i) {
+            int destination;
+
+            if (a[i] < pivot) {
+                destination = nextLess++;
+            }
+
+            else if (pivot < a[i]) {
+                destination = nextGreater++;
+            }
+
+            else {
+                destination = nextEqual++;
+            }
+
+            new (scratch + destination) elmtype(std::move(a[i]));
+        }
+    });
+
+    ParallelFor(helpers, threads, [&](int t) {
+        for (int i = blockStart(t); i < blockStart(t + 1); ++i) {
+            a[i] = std::move(scratch[i]);
+            scratch[i].~elmtype();
+        }
+    });
+
+    delete[] less;
+    delete[] greater;
+}
+
+// Turns 0 into one thread per core
+template <typename elmtype, typename indexing>
+int CDA<elmtype, indexing>::ThreadCount(int threads) {
+    if (threads <= 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+
+    return (threads < 1) ? 1 : threads;
+}
+
+// Introselect over a[low..high). Puts the element of every rank in ks, a
+// sorted array of count indexes, where it would be if a were sorted
+// increasingly. Pivots come from a median of three, or a ninther for big
+// ranges, until depthLimit partitions have been spent. After that, the
+// median of medians guarantees linear time.
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::MultiSelect(elmtype* a, int low, int high, const int* ks, int count, int depthLimit) {
+    while (count > 0) {
+        if (high - low <= insertionSortCutoff) {
+            InsertionSortIncreasing(a + low, high - low);
+            return;
+        }
+
+        int pivotIndex;
+
+        if (depthLimit > 0) {
+            pivotIndex = ChoosePivot(a, low, high);
+            --depthLimit;
         }
 
         else {
-            greater.AddEnd(GetElement(i));
+            pivotIndex = MedianOfMedians(a, low, high);
+        }
+
+        // Everything in a[low..split] is at most everything in a[split + 1..high)
+        int split = HoarePartition(a, low, high, pivotIndex);
+
+        int leftCount = 0;
+        while (leftCount < count && ks[leftCount] <= split) {
+            ++leftCount;
+        }
+
+        // Recurse on the left only when both sides have ranks to find,
+        // and loop on the rest
+        if (leftCount == count) {
+            high = split + 1;
+        }
+
+        else {
+            if (leftCount > 0) {
+                MultiSelect(a, low, split + 1, ks, leftCount, depthLimit);
+            }
+
+            low = split + 1;
+            ks += leftCount;
+            count -= leftCount;
         }
     }
+}
+
+// Partitions a[low..high) around the value at pivotIndex and returns the
+// last index of the left part. Elements equal to the pivot can land on
+// either side, which keeps ranges of duplicates evenly split. Both parts
+// are nonempty.
+template <typename elmtype, typename indexing>
+int CDA<elmtype, indexing>::HoarePartition(elmtype* a, int low, int high, int pivotIndex) {
+    using std::swap;
+    swap(a[low], a[pivotIndex]);
+    elmtype pivot = a[low];
+
+    int i = low - 1;
+    int j = high;
+
+    while (true) {
+        do {
+            ++i;
+        } while (a[i] < pivot);
 
-    if (k - 1 < less.Length()) {
-        return less.Quickselect(k);
+        do {
+            --j;
+        } while (pivot < a[j]);
+
+        if (i >= j) {
+            return j;
+        }
+
+        swap(a[i], a[j]);
     }
+}
+
+// Median of three for small ranges, and a median of three medians of three (a ninther) for big ones
+template <typename elmtype, typename indexing>
+int CDA<elmtype, indexing>::ChoosePivot(const elmtype* a, int low, int high) {
+    int middle = low + (high - low) / 2;
+
+    if (high - low < 128) {
+        return MedianOfThree(a, low, middle, high - 1);
+    }
+
+    int step = (high - low) / 8;
+    int first = MedianOfThree(a, low, low + step, low + 2 * step);
+    int second = MedianOfThree(a, middle - step, middle, middle + step);
+    int third = MedianOfThree(a, high - 1 - 2 * step, high - 1 - step, high - 1);
+
+    return MedianOfThree(a, first, second, third);
+}
+
+template <typename elmtype, typename indexing>
+int CDA<elmtype, indexing>::MedianOfThree(const elmtype* a, int i, int j, int k) {
+    if (a[i] < a[j]) {
+        if (a[j] < a[k]) {
+            return j;
+        }
 
-    else if (k - 1 < less.Length() + equal.Length()) {
-        return pivot;
+        return (a[i] < a[k]) ? k : i;
     }
 
     else {
-        return greater.Quickselect(k - less.Length() - equal.Length());
+        if (a[i] < a[k]) {
+            return i;
+        }
+
+        return (a[j] < a[k]) ? k : j;
     }
 }
 
-template <typename elmtype>
-void CDA<elmtype>::Merge(CDA & array1, CDA & array2) {
-    int i = 0;
-    int j = 0;
+// Moves the median of each group of five to the front of a[low..high),
+// selects the median of those, and returns its index. At least 3/10 of
+// the range is on either side of it.
+template <typename elmtype, typename indexing>
+int CDA<elmtype, indexing>::MedianOfMedians(elmtype* a, int low, int high) {
+    using std::swap;
+    int groups = 0;
+
+    for (int first = low; first < high; first += 5) {
+        int length = (high - first < 5) ? high - first : 5;
+        InsertionSortIncreasing(a + first, length);
+        swap(a[low + groups], a[first + length / 2]);
+        ++groups;
+    }
+
+    int middle = low + groups / 2;
+    MultiSelect(a, low, low + groups, &middle, 1, DepthLimit(groups));
+
+    return middle;
+}
 
-    for (int k = 0; k < size; ++k) {
-        if (i == array1.Length()) {
-            array[k] = array2[j];
-            ++j;
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::InsertionSortIncreasing(elmtype* a, int n) {
+    for (int i = 1; i < n; ++i) {
+        elmtype key = std::move(a[i]);
+        int j;
+
+        for (j = i - 1; j >= 0 && key < a[j]; --j) {
+            a[j + 1] = std::move(a[j]);
         }
 
-        else if (j == array2.Length()) {
-            array[k] = array1[i];
-            ++i;
+        a[j + 1] = std::move(key);
+    }
+}
+
+// Partitions allowed before introselect falls back to the median of
+// medians, twice the depth a balanced recursion would reach
+template <typename elmtype, typename indexing>
+int CDA<elmtype, indexing>::DepthLimit(int n) {
+    int depth = 0;
+
+    while (n > 1) {
+        n /= 2;
+        ++depth;
+    }
+
+    return 2 * depth;
+}
+
+// Runs both tasks, handing the first one to the helper threads if parallel is set
+template <typename elmtype, typename indexing>
+template <typename task1, typename task2>
+void CDA<elmtype, indexing>::ForkJoin(HelperThreads* helpers, bool parallel, task1 first, task2 second) {
+    if (parallel && helpers != nullptr) {
+        helpers->ForkJoin(first, second);
+    }
+
+    else {
+        first();
+        second();
+    }
+}
+
+// Counts how many elements have each value from minimum to maximum, in
+// the order a counting sort will place them. The caller deletes the array.
+template <typename elmtype, typename indexing>
+int* CDA<elmtype, indexing>::CountKeys(int maximum, int minimum, bool increasing) {
+    if (minimum > maximum) {
+        throw (std::string) "CCS1";
+    }
+
+    long long range = (long long) maximum - minimum + 1;
+    int* count = new int[range]();
+    Span span = GetSegments();
+
+    for (int i = 0; i < size; ++i) {
+        const elmtype & e = (i < span.firstLength) ? span.first[i] : span.second[i - span.firstLength];
+
+        if (e < minimum || e > maximum) {
+            delete[] count;
+            throw (std::string) "CCS2";
         }
 
-        else if (array1[i] > array2[j]) {
-            array[k] = array1[i];
-            ++i;
+        ++count[increasing ? e - minimum : maximum - e];
+    }
+
+    return count;
+}
+
+// Runs work(0) through work(threads - 1), sharing them with the helper
+// threads if there are any
+template <typename elmtype, typename indexing>
+template <typename task>
+void CDA<elmtype, indexing>::ParallelFor(HelperThreads* helpers, int threads, task work) {
+    if (helpers != nullptr) {
+        helpers->ParallelFor(threads, work);
+    }
+
+    else {
+        for (int t = 0; t < threads; ++t) {
+            work(t);
+        }
+    }
+}
+
+// Sorts the n elements at source into destination, which must hold n
+// constructed elements. Source is left holding moved-from elements.
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::SortInto(elmtype* source, elmtype* destination, int n, int threads, HelperThreads* helpers) {
+    if (n <= insertionSortCutoff) {
+        for (int i = 0; i < n; ++i) {
+            destination[i] = std::move(source[i]);
+        }
+
+        InsertionSortRange(destination, n);
+        return;
+    }
+
+    int half = n / 2;
+
+    // Each half is sorted where it lies, using the matching part of
+    // destination as scratch, and then merged into destination
+    ForkJoin(helpers, threads > 1 && n >= parallelCutoff, [=]() {
+        SortInPlace(source, destination, half, threads / 2, helpers);
+    }, [=]() {
+        SortInPlace(source + half, destination + half, n - half, threads - threads / 2, helpers);
+    });
+
+    MergeRuns(source, half, source + half, n - half, destination, threads, helpers);
+}
+
+// Sorts the n elements at a, using the n elements at scratch as scratch space
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::SortInPlace(elmtype* a, elmtype* scratch, int n, int threads, HelperThreads* helpers) {
+    if (n <= insertionSortCutoff) {
+        InsertionSortRange(a, n);
+        return;
+    }
+
+    int half = n / 2;
+
+    ForkJoin(helpers, threads > 1 && n >= parallelCutoff, [=]() {
+        SortInto(a, scratch, half, threads / 2, helpers);
+    }, [=]() {
+        SortInto(a + half, scratch + half, n - half, threads - threads / 2, helpers);
+    });
+
+    MergeRuns(scratch, half, scratch + half, n - half, a, threads, helpers);
+}
+
+// Merges two decreasing runs into destination. On ties the element from
+// the right run goes first, which is what reverses equal elements.
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::MergeRuns(elmtype* left, int leftLength, elmtype* right, int rightLength, elmtype* destination, int threads, HelperThreads* helpers) {
+    // Split both runs around the middle of the longer one so the two
+    // halves can be merged at the same time
+    if (threads > 1 && leftLength + rightLength >= parallelCutoff) {
+        int leftSplit;
+        int rightSplit;
+
+        if (leftLength >= rightLength) {
+            leftSplit = leftLength / 2;
+            const elmtype & pivot = left[leftSplit];
+
+            // Right elements equal to the pivot go before it
+            int low = 0;
+            int high = rightLength;
+
+            while (low < high) {
+                int middle = (low + high) / 2;
+
+                if (right[middle] < pivot) {
+                    high = middle;
+                }
+
+                else {
+                    low = middle + 1;
+                }
+            }
+
+            rightSplit = low;
+        }
+
+        else {
+            rightSplit = rightLength / 2;
+            const elmtype & pivot = right[rightSplit];
+
+            // Left elements equal to the pivot go after it
+            int low = 0;
+            int high = leftLength;
+
+            while (low < high) {
+                int middle = (low + high) / 2;
+
+                if (left[middle] > pivot) {
+                    low = middle + 1;
+                }
+
+                else {
+                    high = middle;
+                }
+            }
+
+            leftSplit = low;
+        }
+
+        ForkJoin(helpers, true, [=]() {
+            MergeRuns(left, leftSplit, right, rightSplit, destination, threads / 2, helpers);
+        }, [=]() {
+            MergeRuns(left + leftSplit, leftLength - leftSplit, right + rightSplit, rightLength - rightSplit, destination + leftSplit + rightSplit, threads - threads / 2, helpers);
+        });
+
+        return;
+    }
+
+    int i = 0;
+    int j = 0;
+    int k = 0;
+
+    while (i < leftLength && j < rightLength) {
+        if (left[i] > right[j]) {
+            destination[k++] = std::move(left[i++]);
         }
 
         else {
-            array[k] = array2[j];
-            ++j;
+            destination[k++] = std::move(right[j++]);
+        }
+    }
+
+    while (i < leftLength) {
+        destination[k++] = std::move(left[i++]);
+    }
+
+    while (j < rightLength) {
+        destination[k++] = std::move(right[j++]);
+    }
+}
+
+// Sorts the n elements at a in decreasing order, reversing equal elements like MergeRuns
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::InsertionSortRange(elmtype* a, int n) {
+    for (int i = 1; i < n; ++i) {
+        elmtype key = std::move(a[i]);
+        int j;
+
+        for (j = i - 1; j >= 0 && !(key < a[j]); --j) {
+            a[j + 1] = std::move(a[j]);
         }
+
+        a[j + 1] = std::move(key);
     }
 }
 
-template <typename elmtype>
-int CDA<elmtype>::BinarySearch(elmtype e) {
+template <typename elmtype, typename indexing>
+int CDA<elmtype, indexing>::BinarySearch(elmtype e) {
     int lowerBound = 0;
     int upperBound = size - 1;
     int middle;
@@ -492,20 +1738,130 @@ int CDA<elmtype>::BinarySearch(elmtype e) {
     }
 }
 
-template <typename elmtype>
-int CDA<elmtype>::LinearSearch(elmtype e) {
-    for (int i = 0; i < size; ++i) {
-        if (GetElement(i) == e) {
-            return i;
+// Threads claim blocks of the array in order and scan them. A thread
+// stops once the next block starts past a match some thread has found,
+// since every block before the match has already been claimed.
+template <typename elmtype, typename indexing>
+int CDA<elmtype, indexing>::LinearSearch(elmtype e, int threads) {
+    Span span = GetSegments();
+
+    if (threads == 1 || size < parallelCutoff) {
+        for (int i = 0; i < span.firstLength; ++i) {
+            if (span.first[i] == e) {
+                return i;
+            }
+        }
+
+        for (int i = 0; i < span.secondLength; ++i) {
+            if (span.second[i] == e) {
+                return span.firstLength + i;
+            }
         }
+
+        return -1;
     }
 
-    return -1;
+    std::atomic<int> nextBlock(0);
+    std::atomic<int> firstMatch(size);
+
+    // A search forks only once, so its helpers cost no more than starting
+    // the threads directly
+    HelperThreads helpers(threads - 1);
+
+    ParallelFor(&helpers, threads, [&](int) {
+        while (true) {
+            int start = nextBlock.fetch_add(1, std::memory_order_relaxed) * searchBlockSize;
+
+            if (start >= size || start >= firstMatch.load(std::memory_order_relaxed)) {
+                return;
+            }
+
+            int end = (size - start < searchBlockSize) ? size : start + searchBlockSize;
+
+            for (int i = start; i < end; ++i) {
+                const elmtype & element = (i < span.firstLength) ? span.first[i] : span.second[i - span.firstLength];
+
+                if (element == e) {
+                    // Keep the smallest index any thread has found
+                    int current = firstMatch.load(std::memory_order_relaxed);
+
+                    while (i < current && !firstMatch.compare_exchange_weak(current, i, std::memory_order_relaxed)) {}
+
+                    return;
+                }
+            }
+        }
+    });
+
+    return (firstMatch.load() < size) ? firstMatch.load() : -1;
 }
 
-template <typename elmtype>
-elmtype & CDA<elmtype>::GetElement(int i) {
-    return array[(i + front) % capacity];
+template <typename elmtype, typename indexing>
+elmtype & CDA<elmtype, indexing>::GetElement(int i) {
+    return array[indexing::Slot(i + front, capacity)];
+}
+
+template <typename elmtype, typename indexing>
+const elmtype & CDA<elmtype, indexing>::GetElement(int i) const {
+    return array[indexing::Slot(i + front, capacity)];
+}
+
+template <typename elmtype, typename indexing>
+typename CDA<elmtype, indexing>::Span CDA<elmtype, indexing>::GetSegments() const {
+    Span span;
+    span.first = array + front;
+    span.firstLength = (front + size <= capacity) ? size : capacity - front;
+    span.second = array;
+    span.secondLength = size - span.firstLength;
+    return span;
+}
+
+// Checks if the array is still ordered after adding to the end
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::CheckOrderedEnd() {
+    if (ordered == 1 && GetElement(size - 2) > GetElement(size - 1)) {
+        if (size == 2) {
+            ordered = -1;
+        }
+
+        else {
+            ordered = 0;
+        }
+    }
+
+    else if (ordered == -1 && GetElement(size - 2) < GetElement(size - 1)) {
+        if (size == 2) {
+            ordered = 1;
+        }
+
+        else {
+            ordered = 0;
+        }
+    }
+}
+
+// Checks if the array is still ordered after adding to the front
+template <typename elmtype, typename indexing>
+void CDA<elmtype, indexing>::CheckOrderedFront() {
+    if (ordered == 1 && GetElement(0) > GetElement(1)) {
+        if (size == 2) {
+            ordered = -1;
+        }
+
+        else {
+            ordered = 0;
+        }
+    }
+
+    else if (ordered == -1 && GetElement(0) < GetElement(1)) {
+        if (size == 2) {
+            ordered = 1;
+        }
+
+        else {
+            ordered = 0;
+        }
+    }
 }
 
 #endif
@@ -11,4 +11,15 @@ struct Element {
     valuetype value;
 };
 
+// Elements are ordered by key alone, so containers like CDA can sort them
+template <typename keytype, typename valuetype>
+bool operator<(const Element<keytype, valuetype> & e1, const Element<keytype, valuetype> & e2) {
+    return e1.key < e2.key;
+}
+
+template <typename keytype, typename valuetype>
+bool operator>(const Element<keytype, valuetype> & e1, const Element<keytype, valuetype> & e2) {
+    return e2.key < e1.key;
+}
+
 #endif
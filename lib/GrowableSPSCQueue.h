@@ -0,0 +1,154 @@
+/*
+ * Implements an unbounded lock-free single-producer/single-consumer queue.
+ *
+ * It is a chain of bounded SPSCQueue rings. When the producer fills its
+ * ring, it starts a new one twice as large, pushes there, and links it
+ * after the old one. The consumer drains each ring before following the
+ * link, and frees the rings it leaves behind. The producer never looks at
+ * a ring again once it has moved past it, so the two threads still only
+ * meet at the ring counters and the link.
+*/
+
+#ifndef GROWABLE_SPSC_QUEUE_H
+#define GROWABLE_SPSC_QUEUE_H
+
+#include "SPSCQueue.h"
+#include <atomic>
+#include <utility>
+
+template <typename elmtype>
+class GrowableSPSCQueue {
+    private:
+        struct Segment {
+            SPSCQueue<elmtype> ring;
+            std::atomic<Segment*> next;
+
+            Segment(int s) : ring(s), next(nullptr) {}
+        };
+
+        static const int cacheLineSize = 64;
+
+        alignas(cacheLineSize) Segment* producerSegment;
+        alignas(cacheLineSize) Segment* consumerSegment;
+
+        bool NextSegment();
+
+    public:
+        GrowableSPSCQueue(int s = 64);
+        ~GrowableSPSCQueue();
+        GrowableSPSCQueue(const GrowableSPSCQueue & source) = delete;
+        GrowableSPSCQueue & operator =(const GrowableSPSCQueue & source) = delete;
+        void Push(const elmtype & v);
+        void Push(elmtype && v);
+        template <typename... argtypes>
+        void Emplace(argtypes&&... args);
+        bool TryPop(elmtype & v);
+        void PushBatch(const elmtype items[], int count);
+        int PopBatch(elmtype items[], int count);
+};
+
+// Makes a queue whose first ring holds at least s elements
+template <typename elmtype>
+GrowableSPSCQueue<elmtype>::GrowableSPSCQueue(int s) {
+    producerSegment = new Segment(s);
+    consumerSegment = producerSegment;
+}
+
+template <typename elmtype>
+GrowableSPSCQueue<elmtype>::~GrowableSPSCQueue() {
+    while (consumerSegment != nullptr) {
+        Segment* next = consumerSegment->next.load(std::memory_order_relaxed);
+        delete consumerSegment;
+        consumerSegment = next;
+    }
+}
+
+template <typename elmtype>
+void GrowableSPSCQueue<elmtype>::Push(const elmtype & v) {
+    Emplace(v);
+}
+
+template <typename elmtype>
+void GrowableSPSCQueue<elmtype>::Push(elmtype && v) {
+    Emplace(std::move(v));
+}
+
+// Builds an element at the back from args, growing if the current ring is full
+template <typename elmtype>
+template <typename... argtypes>
+void GrowableSPSCQueue<elmtype>::Emplace(argtypes&&... args) {
+    // A failed TryEmplace leaves args untouched, so they can be used again
+    if (!producerSegment->ring.TryEmplace(std::forward<argtypes>(args)...)) {
+        Segment* segment = new Segment(producerSegment->ring.Capacity() * 2);
+        segment->ring.TryEmplace(std::forward<argtypes>(args)...);
+        producerSegment->next.store(segment, std::memory_order_release);
+        producerSegment = segment;
+    }
+}
+
+// Moves the front element into v. Returns false if the queue is empty.
+template <typename elmtype>
+bool GrowableSPSCQueue<elmtype>::TryPop(elmtype & v) {
+    while (!consumerSegment->ring.TryPop(v)) {
+        if (!NextSegment()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename elmtype>
+void GrowableSPSCQueue<elmtype>::PushBatch(const elmtype items[], int count) {
+    int pushed = producerSegment->ring.PushBatch(items, count);
+
+    while (pushed < count) {
+        // Size the new ring so the rest of the batch fits in it
+        int s = producerSegment->ring.Capacity() * 2;
+
+        while (s < count - pushed) {
+            s *= 2;
+        }
+
+        Segment* segment = new Segment(s);
+        pushed += segment->ring.PushBatch(items + pushed, count - pushed);
+        producerSegment->next.store(segment, std::memory_order_release);
+        producerSegment = segment;
+    }
+}
+
+// Pops up to count elements into items. Returns how many were popped.
+template <typename elmtype>
+int GrowableSPSCQueue<elmtype>::PopBatch(elmtype items[], int count) {
+    int popped = consumerSegment->ring.PopBatch(items, count);
+
+    while (popped < count && NextSegment()) {
+        popped += consumerSegment->ring.PopBatch(items + popped, count - popped);
+    }
+
+    return popped;
+}
+
+// Moves the consumer to the next ring once the current one is drained for
+// good. Returns false if the producer is still using the current ring.
+template <typename elmtype>
+bool GrowableSPSCQueue<elmtype>::NextSegment() {
+    Segment* next = consumerSegment->next.load(std::memory_order_acquire);
+
+    if (next == nullptr) {
+        return false;
+    }
+
+    // Everything pushed to this ring was published before the link, so
+    // if the ring is still empty now it will stay empty.
+    if (!consumerSegment->ring.Empty()) {
+        return true;
+    }
+
+    delete consumerSegment;
+    consumerSegment = next;
+
+    return true;
+}
+
+#endif
@@ -1,25 +1,166 @@
 /*
- * Implements a binary min-heap.
+ * Implements a d-ary min-heap.
  *
  * It can insert elements in O(log n) time,
  * get the minimum element in O(1) time,
  * and remove the minimum element in O(log n) time.
  * It can be used to efficiently implement a priority queue.
+ *
+ * Each node has arity children, 2 by default. A wider heap is shallower,
+ * so inserts touch fewer nodes, while removing the minimum compares more
+ * children at each level. The keys start after arity - 1 unused slots,
+ * which puts every group of siblings at an index that is a multiple of
+ * arity. A 4-ary heap of ints then reads each group from a single cache
+ * line.
+ *
+ * Sifting moves a hole through the array instead of swapping, so each
+ * level costs one move, and the key being sifted is written once at the
+ * end. Keys are only ever added and removed at the back of the CDA, so
+ * they stay in one contiguous run that is read directly through
+ * Segments() rather than the bounds-checked operator[].
 */
 
 #ifndef HEAP_H
 #define HEAP_H
 
 #include "CDA.h"
+#include <functional>
 #include <string>
 #include <sstream>
 #include <iostream>
 #include <utility>
 
-template <typename keytype>
-class Heap {
+// Where the nodes of a d-ary heap sit in its array, and how elements are
+// sifted through it. Shared by Heap, IndexedHeap and PriorityQueue.
+//
+// The sifts take before(x, y), which says whether x belongs above y, and
+// placed(e, index), which is called whenever e is written to index.
+// IndexedHeap uses placed to keep its positions current.
+template <int arity>
+struct HeapLayout {
+    static_assert(arity >= 2, "A heap needs at least two children per node");
+
+    // Index of the root, after the unused slots
+    static const int root = arity - 1;
+
+    static int firstChild(int index);
+    static int parent(int index);
+
+    template <typename elmtype, typename comparer, typename hook>
+    static void siftDown(elmtype* a, int length, int index, comparer before, hook placed);
+    template <typename elmtype, typename comparer, typename hook>
+    static int siftUp(elmtype* a, int index, comparer before, hook placed);
+    template <typename arraytype, typename comparer, typename hook>
+    static void removeAt(arraytype & array, int index, comparer before, hook placed);
+};
+
+// The children of the node at index sit at firstChild(index) up to
+// firstChild(index) + arity - 1. With the root at arity - 1, this is
+// always a multiple of arity. For a binary heap it's 2 * index.
+template <int arity>
+int HeapLayout<arity>::firstChild(int index) {
+    return arity * (index - root + 1);
+}
+
+template <int arity>
+int HeapLayout<arity>::parent(int index) {
+    return (index - root - 1) / arity + root;
+}
+
+template <int arity>
+template <typename elmtype, typename comparer, typename hook>
+void HeapLayout<arity>::siftDown(elmtype* a, int length, int index, comparer before, hook placed) {
+    // Take the element out, leaving a hole at index.
+    // While the first child belongs above the element, move that child up into the hole.
+    // Then put the element in the hole.
+
+    elmtype moving = std::move(a[index]);
+
+    while (true) {
+        int first = firstChild(index);
+
+        if (first >= length) {
+            break;
+        }
+
+        int end = (length - first < arity) ? length : first + arity;
+        int firstChildIndex = first;
+
+        for (int i = first + 1; i < end; ++i) {
+            if (before(a[i], a[firstChildIndex])) {
+                firstChildIndex = i;
+            }
+        }
+
+        if (!before(a[firstChildIndex], moving)) {
+            break;
+        }
+
+        a[index] = std::move(a[firstChildIndex]);
+        placed(a[index], index);
+        index = firstChildIndex;
+    }
+
+    a[index] = std::move(moving);
+    placed(a[index], index);
+}
+
+// Returns the index the element ends up at
+template <int arity>
+template <typename elmtype, typename comparer, typename hook>
+int HeapLayout<arity>::siftUp(elmtype* a, int index, comparer before, hook placed) {
+    // Take the element out, leaving a hole at index.
+    // While the element belongs above the hole's parent, move the parent down into the hole.
+    // Then put the element in the hole.
+
+    elmtype moving = std::move(a[index]);
+
+    while (index > root && before(moving, a[parent(index)])) {
+        a[index] = std::move(a[parent(index)]);
+        placed(a[index], index);
+        index = parent(index);
+    }
+
+    a[index] = std::move(moving);
+    placed(a[index], index);
+
+    return index;
+}
+
+// Removes the element at index from a heap held in a CDA. The last element
+// takes its place and is sifted whichever way it belongs.
+template <int arity>
+template <typename arraytype, typename comparer, typename hook>
+void HeapLayout<arity>::removeAt(arraytype & array, int index, comparer before, hook placed) {
+    int last = array.Length() - 1;
+
+    if (index < last) {
+        auto* a = array.Segments().first;
+        a[index] = std::move(a[last]);
+    }
+
+    // Deleting may move the array to a smaller buffer
+    array.DelEnd();
+
+    if (index < last) {
+        auto* a = array.Segments().first;
+
+        if (siftUp(a, index, before, placed) == index) {
+            siftDown(a, last, index, before, placed);
+        }
+    }
+}
+
+template <typename keytype, int arity = 2>
+class Heap : private HeapLayout<arity> {
     private:
-        CDA<keytype> keys;
+        using HeapLayout<arity>::root;
+        using HeapLayout<arity>::parent;
+        using HeapLayout<arity>::siftDown;
+        using HeapLayout<arity>::siftUp;
+        using HeapLayout<arity>::removeAt;
+
+        CDA<keytype, MaskIndexing> keys;
         keytype junk;
         void percolateDown(int index);
         void percolateUp(int index);
@@ -34,99 +175,80 @@ class Heap {
         std::string stringKey();
 };
 
-template <typename keytype>
-void Heap<keytype>::percolateDown(int index) {
-    // Check if there's a left child. Check if there's a right child. If so, compare them. smallestChildIndex = smallest one.
-    // If you need to, swap index with smallestChild and call percolateDown() recursively.
-
-    int smallestChildIndex = 0;
-
-    if (keys.Length() > 2 * index) { // if keys[index] has a left child
-        if (keys.Length() > 2 * index + 1) { // if keys[index] has a right child
-            smallestChildIndex = (keys[2 * index] < keys[2 * index + 1]) ? (2 * index) : (2 * index + 1);
-        }
-
-        else {
-            smallestChildIndex = 2 * index;
-        }
-
-        if (keys[index] > keys[smallestChildIndex]) {
-            std::swap(keys[index], keys[smallestChildIndex]);
-            percolateDown(smallestChildIndex);
-        }
-    }
+template <typename keytype, int arity>
+void Heap<keytype, arity>::percolateDown(int index) {
+    siftDown(keys.Segments().first, keys.Length(), index, std::less<keytype>(), [](const keytype &, int) {});
 }
 
-template <typename keytype>
-void Heap<keytype>::percolateUp(int index) {
-    // Check if index has a parent.
-    // If so, check if index is smaller than its parent.
-    // If so, swap them and call percolateUp recursively.
-
-    if (index > 1 && keys[index] < keys[index / 2]) {
-        std::swap(keys[index], keys[index / 2]);
-        percolateUp(index / 2);
-    }
+template <typename keytype, int arity>
+void Heap<keytype, arity>::percolateUp(int index) {
+    siftUp(keys.Segments().first, index, std::less<keytype>(), [](const keytype &, int) {});
 }
 
-template <typename keytype>
-Heap<keytype>::Heap() {
-    // Add a single dummy element to the keys array so it starts at index 1
-    keys.AddEnd(junk);
+template <typename keytype, int arity>
+Heap<keytype, arity>::Heap() : junk() {
+    // Add dummy elements to the keys array so the root starts at index arity - 1
+    for (int i = 0; i < root; ++i) {
+        keys.AddEnd(junk);
+    }
 }
 
-template <typename keytype>
-Heap<keytype>::Heap(keytype k[], int s) {
+template <typename keytype, int arity>
+Heap<keytype, arity>::Heap(keytype k[], int s) : junk() {
     // Heapify
 
-    // Add a single dummy element to the keys array so it starts at index 1
-    keys.AddEnd(junk);
+    // Add dummy elements to the keys array so the root starts at index arity - 1
+    for (int i = 0; i < root; ++i) {
+        keys.AddEnd(junk);
+    }
 
     for (int i = 0; i < s; ++i) {
         keys.AddEnd(k[i]);
     }
 
-    for (int i = s; i > 0; --i) {
-        percolateDown(i);
+    // Only nodes up to the parent of the last one have children
+    if (s > 1) {
+        for (int i = parent(keys.Length() - 1); i >= root; --i) {
+            percolateDown(i);
+        }
     }
 }
 
-template <typename keytype>
-keytype Heap<keytype>::peekKey() {
-    return keys[1];
+template <typename keytype, int arity>
+keytype Heap<keytype, arity>::peekKey() {
+    return keys[root];
 }
 
-template <typename keytype>
-keytype Heap<keytype>::extractMin() {
-    // Swap min with last element in heap and delete it.
-    // Percolate the new root down.
-
-    keytype min = keys[1];
+template <typename keytype, int arity>
+keytype Heap<keytype, arity>::extractMin() {
+    // An empty heap goes through operator[], which reports the error
+    if (keys.Length() == root) {
+        return keys[root];
+    }
 
-    std::swap(keys[1], keys[keys.Length() - 1]);
-    keys.DelEnd();
-    percolateDown(1);
+    keytype min = std::move(keys.Segments().first[root]);
+    removeAt(keys, root, std::less<keytype>(), [](const keytype &, int) {});
 
     return min;
 }
 
-template <typename keytype>
-void Heap<keytype>::insert(keytype k) {
-    keys.AddEnd(k);
+template <typename keytype, int arity>
+void Heap<keytype, arity>::insert(keytype k) {
+    keys.AddEnd(std::move(k));
     percolateUp(keys.Length() - 1);
 }
 
-template <typename keytype>
-void Heap<keytype>::printKey() {
+template <typename keytype, int arity>
+void Heap<keytype, arity>::printKey() {
     std::cout << stringKey() << std::endl;
 }
 
-template <typename keytype>
-std::string Heap<keytype>::stringKey() {
+template <typename keytype, int arity>
+std::string Heap<keytype, arity>::stringKey() {
     // Insert each element in keys into a stringstream, then convert it into a string and return it
     std::ostringstream allKeys;
 
-    for (int i = 1; i < keys.Length(); ++i) {
+    for (int i = root; i < keys.Length(); ++i) {
         allKeys << keys[i] << ' ';
     }
 
@@ -0,0 +1,226 @@
+/*
+ * Implements an addressable d-ary min-heap.
+ *
+ * insert returns a handle to the new entry, which stays valid until that
+ * entry is extracted or erased. Through the handle, an entry's key can be
+ * lowered with decreaseKey, raised with increaseKey, or the entry removed
+ * with erase, all in O(log n) time. This lets Dijkstra's algorithm and
+ * schedulers update entries in place instead of inserting duplicates.
+ *
+ * Keys are stored by handle and never move. The heap itself is an array
+ * of handles laid out like Heap, and positions maps each handle back to
+ * its slot in that array. Handles are sifted by the same HeapLayout code
+ * as Heap, which records the new position of every handle it moves.
+ *
+ * Handles of removed entries are reused by later inserts. A removed
+ * entry's key is reset to keytype(), so it holds no memory of its own,
+ * but the arrays indexed by handle only grow: they keep room for the
+ * most entries the heap has ever held at once.
+*/
+
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include "CDA.h"
+#include "Heap.h"
+#include <string>
+#include <utility>
+
+template <typename keytype, int arity = 2>
+class IndexedHeap : private HeapLayout<arity> {
+    private:
+        using HeapLayout<arity>::root;
+        using HeapLayout<arity>::siftDown;
+        using HeapLayout<arity>::siftUp;
+        using HeapLayout<arity>::removeAt;
+
+        // Handles in heap order, after root unused slots
+        CDA<int, MaskIndexing> handles;
+
+        // Indexed by handle. A removed handle has position -1.
+        CDA<keytype> keys;
+        CDA<int> positions;
+
+        // Handles that can be reused
+        CDA<int> freeHandles;
+
+        // Orders handles by their keys
+        struct HandleOrder {
+            keytype* k;
+
+            bool operator()(int x, int y) const { return k[x] < k[y]; }
+        };
+
+        // Records where a handle was written
+        struct RecordPosition {
+            int* p;
+
+            void operator()(int handle, int index) const { p[handle] = index; }
+        };
+
+        HandleOrder order();
+        RecordPosition recorder();
+        void percolateDown(int index);
+        void percolateUp(int index);
+        void checkHandle(int handle);
+
+    public:
+        IndexedHeap();
+        int size();
+        bool empty();
+        bool contains(int handle);
+        keytype getKey(int handle);
+        keytype peekKey();
+        int peekHandle();
+        keytype extractMin();
+        int insert(keytype k);
+        void decreaseKey(int handle, keytype k);
+        void increaseKey(int handle, keytype k);
+        void erase(int handle);
+};
+
+template <typename keytype, int arity>
+typename IndexedHeap<keytype, arity>::HandleOrder IndexedHeap<keytype, arity>::order() {
+    return HandleOrder{keys.Segments().first};
+}
+
+template <typename keytype, int arity>
+typename IndexedHeap<keytype, arity>::RecordPosition IndexedHeap<keytype, arity>::recorder() {
+    return RecordPosition{positions.Segments().first};
+}
+
+template <typename keytype, int arity>
+void IndexedHeap<keytype, arity>::percolateDown(int index) {
+    siftDown(handles.Segments().first, handles.Length(), index, order(), recorder());
+}
+
+template <typename keytype, int arity>
+void IndexedHeap<keytype, arity>::percolateUp(int index) {
+    siftUp(handles.Segments().first, index, order(), recorder());
+}
+
+// Throws if handle does not name an entry in the heap
+template <typename keytype, int arity>
+void IndexedHeap<keytype, arity>::checkHandle(int handle) {
+    if (!contains(handle)) {
+        throw (std::string) "IHH1";
+    }
+}
+
+template <typename keytype, int arity>
+IndexedHeap<keytype, arity>::IndexedHeap() {
+    // Add dummy handles so the root starts at index arity - 1
+    for (int i = 0; i < root; ++i) {
+        handles.AddEnd(-1);
+    }
+}
+
+template <typename keytype, int arity>
+int IndexedHeap<keytype, arity>::size() {
+    return handles.Length() - root;
+}
+
+template <typename keytype, int arity>
+bool IndexedHeap<keytype, arity>::empty() {
+    return size() == 0;
+}
+
+template <typename keytype, int arity>
+bool IndexedHeap<keytype, arity>::contains(int handle) {
+    return handle >= 0 && handle < positions.Length() && positions.Segments().first[handle] != -1;
+}
+
+template <typename keytype, int arity>
+keytype IndexedHeap<keytype, arity>::getKey(int handle) {
+    checkHandle(handle);
+    return keys.Segments().first[handle];
+}
+
+template <typename keytype, int arity>
+keytype IndexedHeap<keytype, arity>::peekKey() {
+    return keys.Segments().first[peekHandle()];
+}
+
+// Returns the handle of the entry with the smallest key
+template <typename keytype, int arity>
+int IndexedHeap<keytype, arity>::peekHandle() {
+    if (empty()) {
+        throw (std::string) "IHE1";
+    }
+
+    return handles.Segments().first[root];
+}
+
+template <typename keytype, int arity>
+keytype IndexedHeap<keytype, arity>::extractMin() {
+    int handle = peekHandle();
+    keytype min = std::move(keys.Segments().first[handle]);
+    erase(handle);
+
+    return min;
+}
+
+template <typename keytype, int arity>
+int IndexedHeap<keytype, arity>::insert(keytype k) {
+    int handle;
+
+    if (freeHandles.Length() > 0) {
+        handle = freeHandles[freeHandles.Length() - 1];
+        freeHandles.DelEnd();
+        keys.Segments().first[handle] = std::move(k);
+    }
+
+    else {
+        handle = keys.Length();
+        keys.AddEnd(std::move(k));
+        positions.AddEnd(-1);
+    }
+
+    handles.AddEnd(handle);
+    percolateUp(handles.Length() - 1);
+
+    return handle;
+}
+
+// Lowers the key of an entry. Throws if k is larger than its current key.
+template <typename keytype, int arity>
+void IndexedHeap<keytype, arity>::decreaseKey(int handle, keytype k) {
+    checkHandle(handle);
+    keytype & current = keys.Segments().first[handle];
+
+    if (k > current) {
+        throw (std::string) "IHD1";
+    }
+
+    current = std::move(k);
+    percolateUp(positions.Segments().first[handle]);
+}
+
+// Raises the key of an entry. Throws if k is smaller than its current key.
+template <typename keytype, int arity>
+void IndexedHeap<keytype, arity>::increaseKey(int handle, keytype k) {
+    checkHandle(handle);
+    keytype & current = keys.Segments().first[handle];
+
+    if (k < current) {
+        throw (std::string) "IHI1";
+    }
+
+    current = std::move(k);
+    percolateDown(positions.Segments().first[handle]);
+}
+
+template <typename keytype, int arity>
+void IndexedHeap<keytype, arity>::erase(int handle) {
+    checkHandle(handle);
+
+    int* p = positions.Segments().first;
+    int index = p[handle];
+    p[handle] = -1;
+    keys.Segments().first[handle] = keytype();
+    freeHandles.AddEnd(handle);
+
+    removeAt(handles, index, order(), recorder());
+}
+
+#endif
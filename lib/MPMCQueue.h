@@ -0,0 +1,329 @@
+/*
+ * Implements a bounded lock-free multi-producer/multi-consumer queue.
+ *
+ * It is a circular array of cells, each holding an element and a
+ * sequence number that says which lap of the ring the cell is ready
+ * for. A producer claims a position by advancing the shared tail with
+ * compare-and-swap once the cell there is free for its lap, writes the
+ * element, and then bumps the cell's sequence to hand it to consumers.
+ * Consumers do the same with the head. Threads only contend on the
+ * head or tail counter, never on a lock, and a slow thread only holds
+ * up the cell it is working on.
+ *
+ * Like SPSCQueue, the capacity is rounded up to a power of two so a
+ * position maps to a cell with a mask (see MaskIndexing in CDA.h).
+*/
+
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include "CDA.h"
+#include <atomic>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+template <typename elmtype>
+class MPMCQueue {
+    private:
+        static const int cacheLineSize = 64;
+
+        struct Cell {
+            std::atomic<long long> sequence;
+            alignas(elmtype) unsigned char storage[sizeof(elmtype)];
+        };
+
+        // Spins with growing pauses, then starts giving up the processor
+        class Backoff {
+            private:
+                static const int spinLimit = 64;
+                int spins;
+
+            public:
+                Backoff() : spins(1) {}
+
+                void Wait() {
+                    if (spins <= spinLimit) {
+                        for (int i = 0; i < spins; ++i) {
+#if defined(__SSE2__)
+                            _mm_pause();
+#endif
+                        }
+
+                        spins *= 2;
+                    }
+
+                    else {
+                        std::this_thread::yield();
+                    }
+                }
+        };
+
+        alignas(cacheLineSize) int capacity;
+        Cell* cells;
+
+        alignas(cacheLineSize) std::atomic<long long> tail;
+        alignas(cacheLineSize) std::atomic<long long> head;
+
+        Cell & GetCell(long long i);
+        elmtype & GetElement(Cell & cell);
+        int ClaimPush(long long & position, int count);
+        int ClaimPop(long long & position, int count);
+
+    public:
+        MPMCQueue(int s);
+        ~MPMCQueue();
+        MPMCQueue(const MPMCQueue & source) = delete;
+        MPMCQueue & operator =(const MPMCQueue & source) = delete;
+        bool TryPush(const elmtype & v);
+        bool TryPush(elmtype && v);
+        template <typename... argtypes>
+        bool TryEmplace(argtypes&&... args);
+        bool TryPop(elmtype & v);
+        void Push(const elmtype & v);
+        void Push(elmtype && v);
+        void Pop(elmtype & v);
+        int PushBatch(const elmtype items[], int count);
+        int PopBatch(elmtype items[], int count);
+        int Length() const;
+        int Capacity() const;
+};
+
+// Makes a queue that holds at least s elements
+template <typename elmtype>
+MPMCQueue<elmtype>::MPMCQueue(int s) : capacity(MaskIndexing::RoundCapacity(s)), tail(0), head(0) {
+    if (s < 1) {
+        throw (std::string) "MQC1";
+    }
+
+    cells = static_cast<Cell*>(::operator new(capacity * sizeof(Cell), std::align_val_t(alignof(Cell))));
+
+    // Cell i is free for the producer that claims position i
+    for (int i = 0; i < capacity; ++i) {
+        new (&cells[i].sequence) std::atomic<long long>(i);
+    }
+}
+
+template <typename elmtype>
+MPMCQueue<elmtype>::~MPMCQueue() {
+    long long t = tail.load(std::memory_order_relaxed);
+
+    for (long long h = head.load(std::memory_order_relaxed); h < t; ++h) {
+        GetElement(GetCell(h)).~elmtype();
+    }
+
+    ::operator delete(cells, std::align_val_t(alignof(Cell)));
+}
+
+template <typename elmtype>
+bool MPMCQueue<elmtype>::TryPush(const elmtype & v) {
+    return TryEmplace(v);
+}
+
+template <typename elmtype>
+bool MPMCQueue<elmtype>::TryPush(elmtype && v) {
+    return TryEmplace(std::move(v));
+}
+
+// Builds an element at the back from args. Returns false if the queue is full.
+template <typename elmtype>
+template <typename... argtypes>
+bool MPMCQueue<elmtype>::TryEmplace(argtypes&&... args) {
+    long long position;
+
+    if (ClaimPush(position, 1) == 0) {
+        return false;
+    }
+
+    Cell & cell = GetCell(position);
+    new (cell.storage) elmtype(std::forward<argtypes>(args)...);
+    cell.sequence.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+// Moves the front element into v. Returns false if the queue is empty.
+template <typename elmtype>
+bool MPMCQueue<elmtype>::TryPop(elmtype & v) {
+    long long position;
+
+    if (ClaimPop(position, 1) == 0) {
+        return false;
+    }
+
+    Cell & cell = GetCell(position);
+    v = std::move(GetElement(cell));
+    GetElement(cell).~elmtype();
+
+    // Free the cell for the producer one lap ahead
+    cell.sequence.store(position + capacity, std::memory_order_release);
+
+    return true;
+}
+
+// Waits for room, backing off while the queue stays full
+template <typename elmtype>
+void MPMCQueue<elmtype>::Push(const elmtype & v) {
+    Backoff backoff;
+
+    while (!TryEmplace(v)) {
+        backoff.Wait();
+    }
+}
+
+template <typename elmtype>
+void MPMCQueue<elmtype>::Push(elmtype && v) {
+    Backoff backoff;
+
+    // A failed TryEmplace leaves v untouched, so it can be tried again
+    while (!TryEmplace(std::move(v))) {
+        backoff.Wait();
+    }
+}
+
+// Waits for an element, backing off while the queue stays empty
+template <typename elmtype>
+void MPMCQueue<elmtype>::Pop(elmtype & v) {
+    Backoff backoff;
+
+    while (!TryPop(v)) {
+        backoff.Wait();
+    }
+}
+
+// Claims a run of free cells with a single compare-and-swap and fills them.
+// Returns how many of the count items were pushed.
+template <typename elmtype>
+int MPMCQueue<elmtype>::PushBatch(const elmtype items[], int count) {
+    if (count <= 0) {
+        return 0;
+    }
+
+    long long position;
+    count = ClaimPush(position, count);
+
+    for (int i = 0; i < count; ++i) {
+        new (GetCell(position + i).storage) elmtype(items[i]);
+    }
+
+    for (int i = 0; i < count; ++i) {
+        GetCell(position + i).sequence.store(position + i + 1, std::memory_order_release);
+    }
+
+    return count;
+}
+
+// Claims a run of filled cells with a single compare-and-swap and empties them.
+// Returns how many elements were popped into items.
+template <typename elmtype>
+int MPMCQueue<elmtype>::PopBatch(elmtype items[], int count) {
+    if (count <= 0) {
+        return 0;
+    }
+
+    long long position;
+    count = ClaimPop(position, count);
+
+    for (int i = 0; i < count; ++i) {
+        Cell & cell = GetCell(position + i);
+        items[i] = std::move(GetElement(cell));
+        GetElement(cell).~elmtype();
+        cell.sequence.store(position + i + capacity, std::memory_order_release);
+    }
+
+    return count;
+}
+
+// Only exact when no thread is running
+template <typename elmtype>
+int MPMCQueue<elmtype>::Length() const {
+    long long h = head.load(std::memory_order_acquire);
+    long long t = tail.load(std::memory_order_acquire);
+    return (t > h) ? t - h : 0;
+}
+
+template <typename elmtype>
+int MPMCQueue<elmtype>::Capacity() const {
+    return capacity;
+}
+
+template <typename elmtype>
+typename MPMCQueue<elmtype>::Cell & MPMCQueue<elmtype>::GetCell(long long i) {
+    return cells[i & (capacity - 1)];
+}
+
+template <typename elmtype>
+elmtype & MPMCQueue<elmtype>::GetElement(Cell & cell) {
+    return *reinterpret_cast<elmtype*>(cell.storage);
+}
+
+// Claims up to count consecutive free cells at the tail. Sets position to
+// the first one and returns how many were claimed, which is 0 when full.
+// count must be positive.
+template <typename elmtype>
+int MPMCQueue<elmtype>::ClaimPush(long long & position, int count) {
+    position = tail.load(std::memory_order_relaxed);
+
+    while (true) {
+        int free = 0;
+
+        while (free < count && GetCell(position + free).sequence.load(std::memory_order_acquire) == position + free) {
+            ++free;
+        }
+
+        if (free == 0) {
+            // The cell is still a lap behind, so the queue is full,
+            // unless another producer already took this position
+            long long sequence = GetCell(position).sequence.load(std::memory_order_acquire);
+
+            if (sequence < position) {
+                return 0;
+            }
+
+            position = tail.load(std::memory_order_relaxed);
+        }
+
+        else if (tail.compare_exchange_weak(position, position + free, std::memory_order_relaxed)) {
+            return free;
+        }
+    }
+}
+
+// Claims up to count consecutive filled cells at the head. Sets position to
+// the first one and returns how many were claimed, which is 0 when empty.
+// count must be positive.
+template <typename elmtype>
+int MPMCQueue<elmtype>::ClaimPop(long long & position, int count) {
+    position = head.load(std::memory_order_relaxed);
+
+    while (true) {
+        int ready = 0;
+
+        while (ready < count && GetCell(position + ready).sequence.load(std::memory_order_acquire) == position + ready + 1) {
+            ++ready;
+        }
+
+        if (ready == 0) {
+            // The cell hasn't been filled for this lap, so the queue is
+            // empty, unless another consumer already took this position
+            long long sequence = GetCell(position).sequence.load(std::memory_order_acquire);
+
+            if (sequence < position + 1) {
+                return 0;
+            }
+
+            position = head.load(std::memory_order_relaxed);
+        }
+
+        else if (head.compare_exchange_weak(position, position + ready, std::memory_order_relaxed)) {
+            return ready;
+        }
+    }
+}
+
+#endif
@@ -1,41 +1,59 @@
 /*
- * Implements a node for a 2-3-4 tree.
+ * Implements a node for a B-tree of the given order. The default order
+ * of 4 is the node of a 2-3-4 tree.
+ *
+ * Keys and values are stored in separate arrays. The keys sit at the
+ * start of a cache line next to the child pointers, so searching a node
+ * for small key types touches a single line no matter how large the
+ * values are. The key array has a spare fourth slot so it can be searched
+ * with a single vector compare (see NodeSearch.h).
+ *
+ * A node doesn't own its children. Trees create and destroy every node
+ * through a NodePool, so nodes can't be copied and never delete children.
 */
 
 #ifndef NODE_H
 #define NODE_H
 
 #include "Element.h"
+#include "NodeSearch.h"
 #include <array>
 #include <string>
 #include <iostream>
 #include <utility>
 
-template <typename keytype, typename valuetype>
+template <typename keytype, typename valuetype, int order = 4>
 class Node {
     private:
-        std::array<Element<keytype, valuetype>, 3> elements;
-        std::array<Node*, 4> children;
-        Node* parent;
+        static_assert(order >= 3, "a node needs room for at least two keys");
+
+        alignas(64) std::array<keytype, nodeKeySlots(order)> keys;
         int numElements;
         int numChildren;
         int size;
+        std::array<Node*, order> children;
+        Node* parent;
+        std::array<valuetype, order - 1> values;
 
     public:
         Node();
         Node(keytype k, valuetype v);
-        ~Node();
-        Node(const Node & oldNode);
-        Node & operator=(const Node & oldTree);
+        Node(const Node & oldNode) = delete;
+        Node & operator=(const Node & oldNode) = delete;
         void insert(keytype k, valuetype v);
         void insert(Element<keytype, valuetype> element);
         void insert(Node* child);
+        void insert(Node* child, int index);
         void remove(keytype k);
+        void removeAt(int index);
         void remove(Element<keytype, valuetype> element);
-        void remove(Node* child);
-        Element<keytype, valuetype> & getElement(int index);
-        Element<keytype, valuetype> & getMaximumElement();
-        Element<keytype, valuetype> & getMinimumElement();
+        Node* release(Node* child);
+        Element<keytype, valuetype> getElement(int index) const;
+        Element<keytype, valuetype> getMaximumElement() const;
+        Element<keytype, valuetype> getMinimumElement() const;
+        void setElement(int index, Element<keytype, valuetype> element);
+        keytype & getKey(int index);
+        valuetype & getValue(int index);
         Node* getChild(int index) const;
         Node* getLeftmostChild() const;
         Node* getRightmostChild() const;
@@ -46,21 +64,22 @@ class Node {
         bool isLeftmostChild() const;
         bool isRightmostChild() const;
         Node* getParent() const;
-        Element<keytype, valuetype> & getLeftParentElement() const;
-        Element<keytype, valuetype> & getRightParentElement() const;
+        Element<keytype, valuetype> getLeftParentElement() const;
+        Element<keytype, valuetype> getRightParentElement() const;
         int getNumElements() const;
         int getNumChildren() const;
         int getSize() const;
         void updateSize();
-        void updateSizeRecursive();
+        void adjustSize(int delta);
         int indexOf(keytype k) const;
+        int indexOfNextChild(keytype k) const;
         int indexOf(const Node* child) const;
         void setParent(Node* newParent);
 };
 
-template <typename keytype, typename valuetype>
-Node<keytype, valuetype>::Node() {
-    for (int i = 0; i < 4; ++i) {
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>::Node() {
+    for (int i = 0; i < order; ++i) {
         children.at(i) = nullptr;
     }
 
@@ -72,12 +91,12 @@ Node<keytype, valuetype>::Node() {
     size = 0;
 }
 
-template <typename keytype, typename valuetype>
-Node<keytype, valuetype>::Node(keytype k, valuetype v) {
-    elements.at(0).key = k;
-    elements.at(0).value = v;
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>::Node(keytype k, valuetype v) {
+    keys.at(0) = k;
+    values.at(0) = v;
 
-    for (int i = 0; i < 4; ++i) {
+    for (int i = 0; i < order; ++i) {
         children.at(i) = nullptr;
     }
 
@@ -88,102 +107,43 @@ Node<keytype, valuetype>::Node(keytype k, valuetype v) {
     size = 1;
 }
 
-template <typename keytype, typename valuetype>
-Node<keytype, valuetype>::~Node() {
-    for (int i = 0; i < numChildren; ++i) {
-        delete children.at(i);
-    }
-}
-
-template <typename keytype, typename valuetype>
-Node<keytype, valuetype>::Node(const Node<keytype, valuetype> & oldNode) {
-    for (int i = 0; i < oldNode.numElements; ++i) {
-        elements.at(i) = oldNode.elements.at(i);
-    }
-
-    for (int i = 0; i < 4; ++i) {
-        children.at(i) = nullptr;
-    }
-
-    for (int i = 0; i < oldNode.numChildren; ++i) {
-        children.at(i) = new Node<keytype, valuetype>;
-        *(children.at(i)) = *(oldNode.children.at(i));
-        children.at(i)->parent = this;
-    }
-
-    parent = nullptr;
-
-    numElements = oldNode.numElements;
-    numChildren = oldNode.numChildren;
-
-    size = oldNode.size;
-}
-
-template <typename keytype, typename valuetype>
-Node<keytype, valuetype> & Node<keytype, valuetype>::operator=(const Node<keytype, valuetype> & oldNode) {
-    if (this != &oldNode) {
-        for (int i = 0; i < oldNode.numElements; ++i) {
-            elements.at(i) = oldNode.elements.at(i);
-        }
-
-        for (int i = 0; i < 4; ++i) {
-            children.at(i) = nullptr;
-        }
-
-        for (int i = 0; i < oldNode.numChildren; ++i) {
-            children.at(i) = new Node<keytype, valuetype>;
-            *(children.at(i)) = *(oldNode.children.at(i));
-            children.at(i)->parent = this;
-        }
-
-        parent = nullptr;
-
-        numElements = oldNode.numElements;
-        numChildren = oldNode.numChildren;
-
-        size = oldNode.size;
-    }
-
-    return *this;
-}
-
-
-template <typename keytype, typename valuetype>
-void Node<keytype, valuetype>::insert(keytype k, valuetype v) {
-    if (numElements == 3) {
+template <typename keytype, typename valuetype, int order>
+void Node<keytype, valuetype, order>::insert(keytype k, valuetype v) {
+    if (numElements == order - 1) {
         throw (std::string) "NI1";
     }
 
     else {
-        Element<keytype, valuetype> newElement;
-        newElement.key = k;
-        newElement.value = v;
+        int i = numElements;
 
-        for (int i = 0; i <= numElements; ++i) {
-            if (newElement.key < elements.at(i).key || i == numElements) {
-                std::swap(elements.at(i), newElement);
-            }
+        // Shift larger keys right, keeping equal keys in insertion order
+        for (; i > 0 && k < keys.at(i - 1); --i) {
+            keys.at(i) = keys.at(i - 1);
+            values.at(i) = values.at(i - 1);
         }
 
+        keys.at(i) = k;
+        values.at(i) = v;
+
         ++numElements;
     }
 }
 
-template <typename keytype, typename valuetype>
-void Node<keytype, valuetype>::insert(Element<keytype, valuetype> element) {
+template <typename keytype, typename valuetype, int order>
+void Node<keytype, valuetype, order>::insert(Element<keytype, valuetype> element) {
     keytype k = element.key;
     valuetype v = element.value;
     this->insert(k, v);
 }
 
-template <typename keytype, typename valuetype>
-void Node<keytype, valuetype>::remove(Element<keytype, valuetype> element) {
+template <typename keytype, typename valuetype, int order>
+void Node<keytype, valuetype, order>::remove(Element<keytype, valuetype> element) {
     keytype k = element.key;
     this->remove(k);
 }
 
-template <typename keytype, typename valuetype>
-void Node<keytype, valuetype>::remove(keytype k) {
+template <typename keytype, typename valuetype, int order>
+void Node<keytype, valuetype, order>::remove(keytype k) {
     if (numElements == 0) {
         throw (std::string) "NRE2";
     }
@@ -193,17 +153,29 @@ void Node<keytype, valuetype>::remove(keytype k) {
     }
 
     else {
-        for (int i = this->indexOf(k); i < numElements - 1; ++i) {
-            elements.at(i) = elements.at(i + 1);
-        }
+        removeAt(this->indexOf(k));
+    }
+}
+
+// Removes the element at index. Unlike remove(k), this picks the right
+// element when several share a key.
+template <typename keytype, typename valuetype, int order>
+void Node<keytype, valuetype, order>::removeAt(int index) {
+    if (index < 0 || index >= numElements) {
+        throw (std::string) "NRA1";
+    }
 
-        --numElements;
+    for (int i = index; i < numElements - 1; ++i) {
+        keys.at(i) = keys.at(i + 1);
+        values.at(i) = values.at(i + 1);
     }
+
+    --numElements;
 }
 
-// Note: never insert another node's child. Always insert a copy.
-template <typename keytype, typename valuetype>
-void Node<keytype, valuetype>::insert(Node<keytype, valuetype>* child) {
+// Note: never insert another node's child. Release it from its old parent first.
+template <typename keytype, typename valuetype, int order>
+void Node<keytype, valuetype, order>::insert(Node<keytype, valuetype, order>* child) {
     if (child == nullptr) {
         throw (std::string) "NIC1";
     }
@@ -213,14 +185,14 @@ void Node<keytype, valuetype>::insert(Node<keytype, valuetype>* child) {
     }
 
     else {
-        Node<keytype, valuetype>* childToMove = child;
+        Node<keytype, valuetype, order>* childToMove = child;
         for (int i = 0; i <= numChildren; ++i) {
             if (i == numChildren) {
                 children.at(i) = childToMove;
             }
 
             else if (children.at(i)->getNumElements() == 0 ||
-                childToMove->getElement(0).key < children.at(i)->getElement(0).key) {
+                childToMove->getKey(0) < children.at(i)->getKey(0)) {
                 std::swap(children.at(i), childToMove);
             }
         }
@@ -229,77 +201,125 @@ void Node<keytype, valuetype>::insert(Node<keytype, valuetype>* child) {
     ++numChildren;
 }
 
-template <typename keytype, typename valuetype>
-void Node<keytype, valuetype>::remove(Node<keytype, valuetype>* child) {
-    if (numChildren == 0) {
-        throw (std::string) "NRC1";
+// Inserts child at a fixed position instead of comparing keys, which
+// keeps subtrees in order when neighbouring children share a key.
+template <typename keytype, typename valuetype, int order>
+void Node<keytype, valuetype, order>::insert(Node<keytype, valuetype, order>* child, int index) {
+    if (child == nullptr) {
+        throw (std::string) "NIC1";
     }
 
-    else if (this->indexOf(child) == -1) {
-        throw (std::string) "NRC2";
+    else if (numChildren == order || index < 0 || index > numChildren) {
+        throw (std::string) "NIC2";
     }
 
     else {
-        int childIndex = indexOf(child);
-        delete children.at(childIndex);
-
-        for (int i = childIndex; i < numChildren - 1; ++i) {
-            children.at(i) = children.at(i + 1);
+        for (int i = numChildren; i > index; --i) {
+            children.at(i) = children.at(i - 1);
         }
 
-        --numChildren;
+        children.at(index) = child;
+        ++numChildren;
+    }
+}
+
+// Unlinks child from this node without deleting it, so the whole
+// subtree can be moved to another node in O(1).
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* Node<keytype, valuetype, order>::release(Node<keytype, valuetype, order>* child) {
+    int childIndex = indexOf(child);
+
+    if (childIndex == -1) {
+        throw (std::string) "NRL1";
+    }
 
-        children.at(numChildren) = nullptr;
+    for (int i = childIndex; i < numChildren - 1; ++i) {
+        children.at(i) = children.at(i + 1);
     }
 
+    --numChildren;
+
+    children.at(numChildren) = nullptr;
+    child->parent = nullptr;
+
+    return child;
 }
 
-template <typename keytype, typename valuetype>
-Element<keytype, valuetype> & Node<keytype, valuetype>::getElement(int n) {
+template <typename keytype, typename valuetype, int order>
+Element<keytype, valuetype> Node<keytype, valuetype, order>::getElement(int n) const {
     if (n >= numElements) {
         throw (std::string) "NGE1";
     }
 
-    return elements.at(n);
+    return {keys.at(n), values.at(n)};
+}
+
+template <typename keytype, typename valuetype, int order>
+Element<keytype, valuetype> Node<keytype, valuetype, order>::getMaximumElement() const {
+    return {keys.at(numElements - 1), values.at(numElements - 1)};
+}
+
+template <typename keytype, typename valuetype, int order>
+Element<keytype, valuetype> Node<keytype, valuetype, order>::getMinimumElement() const {
+    return {keys.at(0), values.at(0)};
+}
+
+// Overwrites the element at index. The caller keeps the keys in order.
+template <typename keytype, typename valuetype, int order>
+void Node<keytype, valuetype, order>::setElement(int n, Element<keytype, valuetype> element) {
+    if (n >= numElements) {
+        throw (std::string) "NSE1";
+    }
+
+    keys.at(n) = element.key;
+    values.at(n) = element.value;
 }
 
-template <typename keytype, typename valuetype>
-Element<keytype, valuetype> & Node<keytype, valuetype>::getMaximumElement() {
-    return elements.at(numElements - 1);
+template <typename keytype, typename valuetype, int order>
+keytype & Node<keytype, valuetype, order>::getKey(int n) {
+    if (n >= numElements) {
+        throw (std::string) "NGK1";
+    }
+
+    return keys.at(n);
 }
 
-template <typename keytype, typename valuetype>
-Element<keytype, valuetype> & Node<keytype, valuetype>::getMinimumElement() {
-    return elements.at(0);
+template <typename keytype, typename valuetype, int order>
+valuetype & Node<keytype, valuetype, order>::getValue(int n) {
+    if (n >= numElements) {
+        throw (std::string) "NGV1";
+    }
+
+    return values.at(n);
 }
 
-template <typename keytype, typename valuetype>
-Node<keytype, valuetype>* Node<keytype, valuetype>::getChild(int n) const {
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* Node<keytype, valuetype, order>::getChild(int n) const {
     return children.at(n);
 }
 
-template <typename keytype, typename valuetype>
-Node<keytype, valuetype>* Node<keytype, valuetype>::getLeftmostChild() const {
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* Node<keytype, valuetype, order>::getLeftmostChild() const {
     return children.at(0);
 }
 
-template <typename keytype, typename valuetype>
-Node<keytype, valuetype>* Node<keytype, valuetype>::getRightmostChild() const {
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* Node<keytype, valuetype, order>::getRightmostChild() const {
     return children.at(numChildren - 1);
 }
 
-template <typename keytype, typename valuetype>
-Node<keytype, valuetype>* Node<keytype, valuetype>::getLeftChildOf(keytype k) const {
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* Node<keytype, valuetype, order>::getLeftChildOf(keytype k) const {
     return children.at(this->indexOf(k));
 }
 
-template <typename keytype, typename valuetype>
-Node<keytype, valuetype>* Node<keytype, valuetype>::getRightChildOf(keytype k) const {
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* Node<keytype, valuetype, order>::getRightChildOf(keytype k) const {
     return children.at(this->indexOf(k) + 1);
 }
 
-template <typename keytype, typename valuetype>
-Node<keytype, valuetype>* Node<keytype, valuetype>::getLeftSibling() const {
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* Node<keytype, valuetype, order>::getLeftSibling() const {
     if (parent->indexOf(this) == 0) {
         return nullptr;
     }
@@ -309,8 +329,8 @@ Node<keytype, valuetype>* Node<keytype, valuetype>::getLeftSibling() const {
     }
 }
 
-template <typename keytype, typename valuetype>
-Node<keytype, valuetype>* Node<keytype, valuetype>::getRightSibling() const {
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* Node<keytype, valuetype, order>::getRightSibling() const {
     if (parent->indexOf(this) == parent->getNumChildren() - 1) {
         return nullptr;
     }
@@ -320,49 +340,49 @@ Node<keytype, valuetype>* Node<keytype, valuetype>::getRightSibling() const {
     }
 }
 
-template <typename keytype, typename valuetype>
-bool Node<keytype, valuetype>::isLeftmostChild() const {
+template <typename keytype, typename valuetype, int order>
+bool Node<keytype, valuetype, order>::isLeftmostChild() const {
     return (parent->indexOf(this) == 0);
 }
 
-template <typename keytype, typename valuetype>
-bool Node<keytype, valuetype>::isRightmostChild() const {
+template <typename keytype, typename valuetype, int order>
+bool Node<keytype, valuetype, order>::isRightmostChild() const {
     return (parent->indexOf(this) == parent->getNumChildren() - 1);
 }
 
-template <typename keytype, typename valuetype>
-Node<keytype, valuetype>* Node<keytype, valuetype>::getParent() const {
+template <typename keytype, typename valuetype, int order>
+Node<keytype, valuetype, order>* Node<keytype, valuetype, order>::getParent() const {
     return parent;
 }
 
-template <typename keytype, typename valuetype>
-Element<keytype, valuetype> & Node<keytype, valuetype>::getLeftParentElement() const {
+template <typename keytype, typename valuetype, int order>
+Element<keytype, valuetype> Node<keytype, valuetype, order>::getLeftParentElement() const {
     int x = parent->indexOf(this) - 1;
     return parent->getElement(x);
 }
 
-template <typename keytype, typename valuetype>
-Element<keytype, valuetype> & Node<keytype, valuetype>::getRightParentElement() const {
+template <typename keytype, typename valuetype, int order>
+Element<keytype, valuetype> Node<keytype, valuetype, order>::getRightParentElement() const {
     return parent->getElement(parent->indexOf(this));
 }
 
-template <typename keytype, typename valuetype>
-int Node<keytype, valuetype>::getNumElements() const {
+template <typename keytype, typename valuetype, int order>
+int Node<keytype, valuetype, order>::getNumElements() const {
     return numElements;
 }
 
-template <typename keytype, typename valuetype>
-int Node<keytype, valuetype>::getNumChildren() const {
+template <typename keytype, typename valuetype, int order>
+int Node<keytype, valuetype, order>::getNumChildren() const {
     return numChildren;
 }
 
-template <typename keytype, typename valuetype>
-int Node<keytype, valuetype>::getSize() const {
+template <typename keytype, typename valuetype, int order>
+int Node<keytype, valuetype, order>::getSize() const {
     return size;
 }
 
-template <typename keytype, typename valuetype>
-void Node<keytype, valuetype>::updateSize() {
+template <typename keytype, typename valuetype, int order>
+void Node<keytype, valuetype, order>::updateSize() {
     size = numElements;
 
     for (int i = 0; i < numChildren; ++i) {
@@ -370,28 +390,25 @@ void Node<keytype, valuetype>::updateSize() {
     }
 }
 
-template <typename keytype, typename valuetype>
-void Node<keytype, valuetype>::updateSizeRecursive() {
-    this->updateSize();
-
-    if (parent != nullptr) {
-        parent->updateSizeRecursive();
-    }
+// Lets a tree keep sizes current on its way down instead of recounting afterwards
+template <typename keytype, typename valuetype, int order>
+void Node<keytype, valuetype, order>::adjustSize(int delta) {
+    size += delta;
 }
 
-template <typename keytype, typename valuetype>
-int Node<keytype, valuetype>::indexOf(keytype k) const {
-    for (int i = 0; i < numElements; ++i) {
-        if (k == elements.at(i).key) {
-            return i;
-        }
-    }
+template <typename keytype, typename valuetype, int order>
+int Node<keytype, valuetype, order>::indexOf(keytype k) const {
+    return NodeSearch<keytype>::indexOf(keys.data(), numElements, k);
+}
 
-    return -1;
+// Returns the index of the child whose subtree k belongs in.
+template <typename keytype, typename valuetype, int order>
+int Node<keytype, valuetype, order>::indexOfNextChild(keytype k) const {
+    return NodeSearch<keytype>::childIndex(keys.data(), numElements, k);
 }
 
-template <typename keytype, typename valuetype>
-int Node<keytype, valuetype>::indexOf(const Node<keytype, valuetype>* child) const {
+template <typename keytype, typename valuetype, int order>
+int Node<keytype, valuetype, order>::indexOf(const Node<keytype, valuetype, order>* child) const {
     for (int i = 0; i < numChildren; ++i) {
         if (child == children.at(i)) {
             return i;
@@ -401,8 +418,8 @@ int Node<keytype, valuetype>::indexOf(const Node<keytype, valuetype>* child) con
     return -1;
 }
 
-template <typename keytype, typename valuetype>
-void Node<keytype, valuetype>::setParent(Node<keytype, valuetype>* newParent) {
+template <typename keytype, typename valuetype, int order>
+void Node<keytype, valuetype, order>::setParent(Node<keytype, valuetype, order>* newParent) {
     parent = newParent;
 }
 
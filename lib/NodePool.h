@@ -0,0 +1,220 @@
+/*
+ * Implements a slab allocator for tree nodes.
+ *
+ * Nodes are carved out of large slabs and recycled through a free list,
+ * so building a tree with millions of nodes costs a few dozen calls to
+ * the system allocator instead of one per node. Slabs start small and
+ * double in size up to a fixed limit. Destroying the pool releases
+ * every slab at once without visiting the nodes inside them.
+*/
+
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include "CDA.h"
+#include <cstddef>
+#include <new>
+#include <utility>
+
+template <typename nodetype>
+class NodePool {
+    private:
+        union Slot {
+            Slot* next;
+            alignas(nodetype) unsigned char storage[sizeof(nodetype)];
+        };
+
+        static const int firstSlabSize = 16;
+        static const int maxSlabSize = 4096;
+
+        CDA<Slot*> slabs;
+        int numSlabs;
+        Slot* freeList;
+        Slot* freeTail;
+
+        // Slots of the current slab that have never been handed out
+        Slot* nextSlot;
+        Slot* slabEnd;
+
+        int liveNodes;
+        long long bytesReserved;
+
+        int slabCapacity(int slabIndex) const;
+        Slot* allocateSlot();
+
+    public:
+        friend void swap(NodePool & pool1, NodePool & pool2) {
+            using std::swap;
+            swap(pool1.slabs, pool2.slabs);
+            swap(pool1.numSlabs, pool2.numSlabs);
+            swap(pool1.freeList, pool2.freeList);
+            swap(pool1.freeTail, pool2.freeTail);
+            swap(pool1.nextSlot, pool2.nextSlot);
+            swap(pool1.slabEnd, pool2.slabEnd);
+            swap(pool1.liveNodes, pool2.liveNodes);
+            swap(pool1.bytesReserved, pool2.bytesReserved);
+        }
+
+        NodePool();
+        ~NodePool();
+        NodePool(const NodePool & oldPool) = delete;
+        NodePool & operator=(const NodePool & oldPool) = delete;
+        template <typename... argtypes>
+        nodetype* create(argtypes&&... args);
+        void destroy(nodetype* node);
+        void splice(NodePool & other);
+        void clear();
+        int getLiveNodes() const;
+        int getSlabCount() const;
+        long long getBytesReserved() const;
+};
+
+template <typename nodetype>
+NodePool<nodetype>::NodePool() : numSlabs(0), freeList(nullptr), freeTail(nullptr), nextSlot(nullptr), slabEnd(nullptr), liveNodes(0), bytesReserved(0) {}
+
+template <typename nodetype>
+NodePool<nodetype>::~NodePool() {
+    clear();
+}
+
+// Constructs a node in a free slot. Slots released by destroy() are reused first.
+template <typename nodetype>
+template <typename... argtypes>
+nodetype* NodePool<nodetype>::create(argtypes&&... args) {
+    Slot* slot = allocateSlot();
+    nodetype* node = new (slot->storage) nodetype(std::forward<argtypes>(args)...);
+    ++liveNodes;
+    return node;
+}
+
+// Runs the node's destructor and puts its slot on the free list.
+// The node must not own any children, since they live in the pool too.
+template <typename nodetype>
+void NodePool<nodetype>::destroy(nodetype* node) {
+    node->~nodetype();
+
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->next = freeList;
+    freeList = slot;
+
+    if (freeTail == nullptr) {
+        freeTail = slot;
+    }
+
+    --liveNodes;
+}
+
+// Takes over every slab of other, so nodes created by other now belong to
+// this pool and other is left empty. Other's free slots are linked after
+// this pool's own. Of the two current slabs, the one with more unused
+// slots stays current, and the unused slots of the other one are not
+// handed out again. Takes O(1) time plus one step per slab of other.
+template <typename nodetype>
+void NodePool<nodetype>::splice(NodePool & other) {
+    if (&other == this || other.numSlabs == 0) {
+        return;
+    }
+
+    for (int i = 0; i < other.numSlabs; ++i) {
+        slabs.AddEnd(other.slabs[i]);
+    }
+
+    numSlabs += other.numSlabs;
+    liveNodes += other.liveNodes;
+    bytesReserved += other.bytesReserved;
+
+    if (freeList == nullptr) {
+        freeList = other.freeList;
+        freeTail = other.freeTail;
+    }
+
+    else if (other.freeList != nullptr) {
+        freeTail->next = other.freeList;
+        freeTail = other.freeTail;
+    }
+
+    if (other.slabEnd - other.nextSlot > slabEnd - nextSlot) {
+        nextSlot = other.nextSlot;
+        slabEnd = other.slabEnd;
+    }
+
+    other.slabs.Clear();
+    other.numSlabs = 0;
+    other.freeList = nullptr;
+    other.freeTail = nullptr;
+    other.nextSlot = nullptr;
+    other.slabEnd = nullptr;
+    other.liveNodes = 0;
+    other.bytesReserved = 0;
+}
+
+// Releases every slab without running node destructors. The caller is
+// responsible for destroying nodes whose members need it first.
+template <typename nodetype>
+void NodePool<nodetype>::clear() {
+    for (int i = 0; i < numSlabs; ++i) {
+        delete[] slabs[i];
+    }
+
+    slabs.Clear();
+    numSlabs = 0;
+    freeList = nullptr;
+    freeTail = nullptr;
+    nextSlot = nullptr;
+    slabEnd = nullptr;
+    liveNodes = 0;
+    bytesReserved = 0;
+}
+
+template <typename nodetype>
+int NodePool<nodetype>::getLiveNodes() const {
+    return liveNodes;
+}
+
+template <typename nodetype>
+int NodePool<nodetype>::getSlabCount() const {
+    return numSlabs;
+}
+
+template <typename nodetype>
+long long NodePool<nodetype>::getBytesReserved() const {
+    return bytesReserved;
+}
+
+template <typename nodetype>
+int NodePool<nodetype>::slabCapacity(int slabIndex) const {
+    int capacity = firstSlabSize;
+
+    for (int i = 0; i < slabIndex && capacity < maxSlabSize; ++i) {
+        capacity *= 2;
+    }
+
+    return capacity;
+}
+
+template <typename nodetype>
+typename NodePool<nodetype>::Slot* NodePool<nodetype>::allocateSlot() {
+    if (freeList != nullptr) {
+        Slot* slot = freeList;
+        freeList = freeList->next;
+
+        if (freeList == nullptr) {
+            freeTail = nullptr;
+        }
+
+        return slot;
+    }
+
+    if (nextSlot == slabEnd) {
+        int capacity = slabCapacity(numSlabs);
+        nextSlot = new Slot[capacity];
+        slabEnd = nextSlot + capacity;
+        slabs.AddEnd(nextSlot);
+        bytesReserved += capacity * sizeof(Slot);
+        ++numSlabs;
+    }
+
+    return nextSlot++;
+}
+
+#endif
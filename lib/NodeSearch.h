@@ -0,0 +1,258 @@
+/*
+ * Implements the key search inside a single B-tree node.
+ *
+ * A node keeps its keys sorted in an array padded to a multiple of four
+ * slots, so arithmetic keys can be compared four at a time with vector
+ * loads. A 2-3-4 tree node needs exactly one load. The vector versions
+ * are picked at compile time through template specialization. Every
+ * other key type, including std::string, uses a plain loop for small
+ * nodes and a binary search for wide ones.
+ *
+ * childIndex() returns how many keys are less than or equal to k, which
+ * is the index of the child to descend into. indexOf() returns the first
+ * slot holding k, or -1.
+*/
+
+#ifndef NODE_SEARCH_H
+#define NODE_SEARCH_H
+
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Number of key slots in a node of the given order. The order - 1 keys
+// are rounded up to whole groups of four so vector loads stay in bounds.
+constexpr int nodeKeySlots(int order) {
+    return (order + 2) / 4 * 4;
+}
+
+// Mask of the live lanes in the group of four keys starting at index first
+inline int liveLanes(int numElements, int first) {
+    return (numElements - first >= 4) ? 0xF : (1 << (numElements - first)) - 1;
+}
+
+template <typename keytype, typename enable = void>
+struct NodeSearch {
+    static const int linearLimit = 8;
+
+    static int childIndex(const keytype* keys, int numElements, const keytype & k) {
+        if (numElements <= linearLimit) {
+            int i = 0;
+
+            while (i < numElements && !(k < keys[i])) {
+                ++i;
+            }
+
+            return i;
+        }
+
+        // First key greater than k
+        int low = 0;
+        int high = numElements;
+
+        while (low < high) {
+            int middle = (low + high) / 2;
+
+            if (k < keys[middle]) {
+                high = middle;
+            }
+
+            else {
+                low = middle + 1;
+            }
+        }
+
+        return low;
+    }
+
+    static int indexOf(const keytype* keys, int numElements, const keytype & k) {
+        if (numElements <= linearLimit) {
+            for (int i = 0; i < numElements; ++i) {
+                if (k == keys[i]) {
+                    return i;
+                }
+            }
+
+            return -1;
+        }
+
+        // First key not less than k
+        int low = 0;
+        int high = numElements;
+
+        while (low < high) {
+            int middle = (low + high) / 2;
+
+            if (keys[middle] < k) {
+                low = middle + 1;
+            }
+
+            else {
+                high = middle;
+            }
+        }
+
+        return (low < numElements && keys[low] == k) ? low : -1;
+    }
+};
+
+#if defined(__SSE2__)
+
+// 32-bit integers, compared four at a time
+template <typename keytype>
+struct NodeSearch<keytype, typename std::enable_if<std::is_integral<keytype>::value && sizeof(keytype) == 4>::type> {
+    static __m128i load(const keytype* keys) {
+        __m128i keyVector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys));
+
+        // Flip the sign bit so unsigned keys compare correctly as signed
+        if (std::is_unsigned<keytype>::value) {
+            keyVector = _mm_xor_si128(keyVector, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+        }
+
+        return keyVector;
+    }
+
+    static __m128i broadcast(const keytype & k) {
+        int target = static_cast<int>(k);
+
+        if (std::is_unsigned<keytype>::value) {
+            target ^= static_cast<int>(0x80000000u);
+        }
+
+        return _mm_set1_epi32(target);
+    }
+
+    static int childIndex(const keytype* keys, int numElements, const keytype & k) {
+        __m128i target = broadcast(k);
+        int greater = 0;
+
+        for (int i = 0; i < numElements; i += 4) {
+            __m128i compare = _mm_cmpgt_epi32(load(keys + i), target);
+            greater += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(compare)) & liveLanes(numElements, i));
+        }
+
+        return numElements - greater;
+    }
+
+    static int indexOf(const keytype* keys, int numElements, const keytype & k) {
+        __m128i target = broadcast(k);
+
+        for (int i = 0; i < numElements; i += 4) {
+            __m128i equal = _mm_cmpeq_epi32(load(keys + i), target);
+            int mask = _mm_movemask_ps(_mm_castsi128_ps(equal)) & liveLanes(numElements, i);
+
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+
+        return -1;
+    }
+};
+
+template <>
+struct NodeSearch<float> {
+    static int childIndex(const float* keys, int numElements, const float & k) {
+        __m128 target = _mm_set1_ps(k);
+        int greater = 0;
+
+        for (int i = 0; i < numElements; i += 4) {
+            __m128 compare = _mm_cmpgt_ps(_mm_loadu_ps(keys + i), target);
+            greater += __builtin_popcount(_mm_movemask_ps(compare) & liveLanes(numElements, i));
+        }
+
+        return numElements - greater;
+    }
+
+    static int indexOf(const float* keys, int numElements, const float & k) {
+        __m128 target = _mm_set1_ps(k);
+
+        for (int i = 0; i < numElements; i += 4) {
+            int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(keys + i), target)) & liveLanes(numElements, i);
+
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+
+        return -1;
+    }
+};
+
+#endif
+
+#if defined(__AVX2__)
+
+// 64-bit signed integers, compared four at a time
+template <typename keytype>
+struct NodeSearch<keytype, typename std::enable_if<std::is_integral<keytype>::value && std::is_signed<keytype>::value && sizeof(keytype) == 8>::type> {
+    static __m256i load(const keytype* keys) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys));
+    }
+
+    static int childIndex(const keytype* keys, int numElements, const keytype & k) {
+        __m256i target = _mm256_set1_epi64x(k);
+        int greater = 0;
+
+        for (int i = 0; i < numElements; i += 4) {
+            __m256i compare = _mm256_cmpgt_epi64(load(keys + i), target);
+            greater += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(compare)) & liveLanes(numElements, i));
+        }
+
+        return numElements - greater;
+    }
+
+    static int indexOf(const keytype* keys, int numElements, const keytype & k) {
+        __m256i target = _mm256_set1_epi64x(k);
+
+        for (int i = 0; i < numElements; i += 4) {
+            __m256i equal = _mm256_cmpeq_epi64(load(keys + i), target);
+            int mask = _mm256_movemask_pd(_mm256_castsi256_pd(equal)) & liveLanes(numElements, i);
+
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+
+        return -1;
+    }
+};
+
+template <>
+struct NodeSearch<double> {
+    static int childIndex(const double* keys, int numElements, const double & k) {
+        __m256d target = _mm256_set1_pd(k);
+        int greater = 0;
+
+        for (int i = 0; i < numElements; i += 4) {
+            __m256d compare = _mm256_cmp_pd(_mm256_loadu_pd(keys + i), target, _CMP_GT_OQ);
+            greater += __builtin_popcount(_mm256_movemask_pd(compare) & liveLanes(numElements, i));
+        }
+
+        return numElements - greater;
+    }
+
+    static int indexOf(const double* keys, int numElements, const double & k) {
+        __m256d target = _mm256_set1_pd(k);
+
+        for (int i = 0; i < numElements; i += 4) {
+            int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(keys + i), target, _CMP_EQ_OQ)) & liveLanes(numElements, i);
+
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+
+        return -1;
+    }
+};
+
+#endif
+
+#endif
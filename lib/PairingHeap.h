@@ -0,0 +1,250 @@
+/*
+ * Implements a pairing heap.
+ *
+ * It can insert elements in O(1) time,
+ * meld two heaps in O(1) time plus a step per slab of the other heap's pool,
+ * get the minimum element in O(1) time,
+ * remove the minimum element in O(log n) amortized time,
+ * and lower a key in O(log n) amortized time, usually far less.
+ * It has the same insert, peekKey and extractMin as Heap, and suits
+ * graph searches that mostly insert and decrease keys.
+ *
+ * The heap is a tree where every node's key is no larger than its
+ * children's. Each node points to its first child, its next sibling, and
+ * back to its previous sibling, or to its parent if it is the first child.
+ * Two trees are linked by making the one with the larger root the first
+ * child of the other. Removing the root links its children in pairs from
+ * left to right, then links the pairs from right to left.
+ *
+ * insert returns a handle to the new node, which stays valid until that
+ * key is extracted. Nodes come from a NodePool, which meld splices into
+ * this heap's. Slabs hold up to 4096 nodes, so melding a large heap costs
+ * a step per 4096 of its keys. Each meld may also leave the unused end of
+ * one slab behind until the heap is destroyed.
+*/
+
+#ifndef PAIRING_HEAP_H
+#define PAIRING_HEAP_H
+
+#include "CDA.h"
+#include "NodePool.h"
+#include <string>
+#include <type_traits>
+#include <utility>
+
+template <typename keytype>
+class PairingHeap {
+    private:
+        struct PairingNode {
+            keytype key;
+            PairingNode* child;
+            PairingNode* next;
+            PairingNode* prev;
+
+            PairingNode(keytype k) : key(std::move(k)), child(nullptr), next(nullptr), prev(nullptr) {}
+        };
+
+        NodePool<PairingNode> pool;
+        PairingNode* root;
+        int count;
+
+        static PairingNode* link(PairingNode* first, PairingNode* second);
+        static PairingNode* mergePairs(PairingNode* first);
+        static void cut(PairingNode* node);
+
+    public:
+        typedef PairingNode* Handle;
+
+        PairingHeap();
+        ~PairingHeap();
+        PairingHeap(const PairingHeap & source) = delete;
+        PairingHeap & operator=(const PairingHeap & source) = delete;
+        int size();
+        bool empty();
+        keytype peekKey();
+        keytype extractMin();
+        Handle insert(keytype k);
+        void decreaseKey(Handle node, keytype k);
+        void meld(PairingHeap & other);
+};
+
+// Links two trees and returns the root of the result. The roots' sibling
+// pointers are not used and are left for the caller to set.
+template <typename keytype>
+typename PairingHeap<keytype>::PairingNode* PairingHeap<keytype>::link(PairingNode* first, PairingNode* second) {
+    if (second->key < first->key) {
+        std::swap(first, second);
+    }
+
+    second->next = first->child;
+
+    if (first->child != nullptr) {
+        first->child->prev = second;
+    }
+
+    second->prev = first;
+    first->child = second;
+
+    return first;
+}
+
+// Links a list of siblings into one tree and returns its root
+template <typename keytype>
+typename PairingHeap<keytype>::PairingNode* PairingHeap<keytype>::mergePairs(PairingNode* first) {
+    // First pass: link the siblings in pairs from left to right,
+    // pushing each pair onto a list threaded through next, so the
+    // list ends up in reverse order.
+    // Second pass: pop the pairs, linking each into the result.
+
+    PairingNode* pairs = nullptr;
+
+    while (first != nullptr) {
+        PairingNode* second = first->next;
+
+        if (second == nullptr) {
+            first->next = pairs;
+            pairs = first;
+            break;
+        }
+
+        PairingNode* rest = second->next;
+        PairingNode* pair = link(first, second);
+        pair->next = pairs;
+        pairs = pair;
+        first = rest;
+    }
+
+    PairingNode* result = pairs;
+    pairs = pairs->next;
+
+    while (pairs != nullptr) {
+        PairingNode* rest = pairs->next;
+        result = link(result, pairs);
+        pairs = rest;
+    }
+
+    result->next = nullptr;
+    result->prev = nullptr;
+
+    return result;
+}
+
+// Detaches the subtree rooted at node, which must not be the root
+template <typename keytype>
+void PairingHeap<keytype>::cut(PairingNode* node) {
+    if (node->prev->child == node) {
+        node->prev->child = node->next;
+    }
+
+    else {
+        node->prev->next = node->next;
+    }
+
+    if (node->next != nullptr) {
+        node->next->prev = node->prev;
+    }
+
+    node->next = nullptr;
+    node->prev = nullptr;
+}
+
+template <typename keytype>
+PairingHeap<keytype>::PairingHeap() : root(nullptr), count(0) {}
+
+template <typename keytype>
+PairingHeap<keytype>::~PairingHeap() {
+    // Nodes holding plain data don't need their destructors run,
+    // so the pool can hand its slabs back without visiting them.
+    if (!std::is_trivially_destructible<keytype>::value && root != nullptr) {
+        CDA<PairingNode*> stack;
+        stack.AddEnd(root);
+
+        while (stack.Length() > 0) {
+            PairingNode* node = stack[stack.Length() - 1];
+            stack.DelEnd();
+
+            for (PairingNode* c = node->child; c != nullptr; c = c->next) {
+                stack.AddEnd(c);
+            }
+
+            pool.destroy(node);
+        }
+    }
+}
+
+template <typename keytype>
+int PairingHeap<keytype>::size() {
+    return count;
+}
+
+template <typename keytype>
+bool PairingHeap<keytype>::empty() {
+    return count == 0;
+}
+
+template <typename keytype>
+keytype PairingHeap<keytype>::peekKey() {
+    if (root == nullptr) {
+        throw (std::string) "PHE1";
+    }
+
+    return root->key;
+}
+
+template <typename keytype>
+keytype PairingHeap<keytype>::extractMin() {
+    if (root == nullptr) {
+        throw (std::string) "PHE1";
+    }
+
+    PairingNode* old = root;
+    keytype min = std::move(old->key);
+    root = (old->child != nullptr) ? mergePairs(old->child) : nullptr;
+    pool.destroy(old);
+    --count;
+
+    return min;
+}
+
+template <typename keytype>
+typename PairingHeap<keytype>::Handle PairingHeap<keytype>::insert(keytype k) {
+    PairingNode* node = pool.create(std::move(k));
+    root = (root != nullptr) ? link(root, node) : node;
+    ++count;
+
+    return node;
+}
+
+// Lowers the key of a node. Throws if k is larger than its current key.
+template <typename keytype>
+void PairingHeap<keytype>::decreaseKey(Handle node, keytype k) {
+    if (k > node->key) {
+        throw (std::string) "PHD1";
+    }
+
+    node->key = std::move(k);
+
+    if (node != root) {
+        cut(node);
+        root = link(root, node);
+    }
+}
+
+// Moves every key of other into this heap, leaving other empty.
+// Handles into other stay valid and now belong to this heap.
+// Takes O(1) time plus a step per slab of other's pool.
+template <typename keytype>
+void PairingHeap<keytype>::meld(PairingHeap & other) {
+    if (&other == this || other.root == nullptr) {
+        return;
+    }
+
+    pool.splice(other.pool);
+    root = (root != nullptr) ? link(root, other.root) : other.root;
+    count += other.count;
+
+    other.root = nullptr;
+    other.count = 0;
+}
+
+#endif
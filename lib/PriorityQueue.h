@@ -0,0 +1,197 @@
+/*
+ * Implements a d-ary priority queue of keys with payloads.
+ *
+ * Entries are ordered by compare, which by default puts the smallest key
+ * first. std::greater makes it a max-queue, as MaxPriorityQueue does.
+ *
+ * The heap holds small entries of a key and the slot of its payload, and
+ * the payloads live out of line in a CDA indexed by slot. Sifting only
+ * moves those entries, 16 bytes for an 8-byte key, however large the
+ * payloads are. A payload is moved once on insert and once on extract.
+ * Slots of extracted payloads are reused by later inserts.
+ *
+ * The entries are laid out like Heap, and sifted by the same HeapLayout
+ * code.
+*/
+
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+#include "CDA.h"
+#include "Element.h"
+#include "Heap.h"
+#include <functional>
+#include <string>
+#include <utility>
+
+template <typename keytype, typename valuetype, typename compare = std::less<keytype>, int arity = 2>
+class PriorityQueue : private HeapLayout<arity> {
+    private:
+        using HeapLayout<arity>::root;
+        using HeapLayout<arity>::parent;
+        using HeapLayout<arity>::siftDown;
+        using HeapLayout<arity>::siftUp;
+        using HeapLayout<arity>::removeAt;
+
+        struct Entry {
+            keytype key;
+            int slot;
+
+            // CDA needs an order to track whether it is sorted. The heap
+            // itself only compares keys with compare, so use the slot,
+            // which works for any key type.
+            bool operator<(const Entry & other) const { return slot < other.slot; }
+            bool operator>(const Entry & other) const { return slot > other.slot; }
+        };
+
+        // Entries in heap order, after root unused slots
+        CDA<Entry, MaskIndexing> entries;
+
+        // Payloads need no order of their own, so they are wrapped in a
+        // type whose comparisons tell CDA they are all equal
+        struct Payload {
+            valuetype value;
+
+            bool operator<(const Payload &) const { return false; }
+            bool operator>(const Payload &) const { return false; }
+        };
+
+        // Payloads by slot, and the slots that can be reused
+        CDA<Payload> values;
+        CDA<int> freeSlots;
+
+        compare before;
+
+        // Orders entries by key under compare
+        struct EntryOrder {
+            compare & before;
+
+            bool operator()(const Entry & x, const Entry & y) const { return before(x.key, y.key); }
+        };
+
+        void percolateDown(int index);
+        void percolateUp(int index);
+        void addPadding();
+        int store(valuetype v);
+        Entry & top();
+
+    public:
+        PriorityQueue(compare c = compare());
+        PriorityQueue(Element<keytype, valuetype> e[], int s, compare c = compare());
+        int size();
+        bool empty();
+        keytype peekKey();
+        valuetype peekValue();
+        Element<keytype, valuetype> extractMin();
+        void insert(keytype k, valuetype v);
+};
+
+// A priority queue that puts the largest key first
+template <typename keytype, typename valuetype, int arity = 2>
+using MaxPriorityQueue = PriorityQueue<keytype, valuetype, std::greater<keytype>, arity>;
+
+template <typename keytype, typename valuetype, typename compare, int arity>
+void PriorityQueue<keytype, valuetype, compare, arity>::percolateDown(int index) {
+    siftDown(entries.Segments().first, entries.Length(), index, EntryOrder{before}, [](const Entry &, int) {});
+}
+
+template <typename keytype, typename valuetype, typename compare, int arity>
+void PriorityQueue<keytype, valuetype, compare, arity>::percolateUp(int index) {
+    siftUp(entries.Segments().first, index, EntryOrder{before}, [](const Entry &, int) {});
+}
+
+// Adds dummy entries so the root starts at index arity - 1
+template <typename keytype, typename valuetype, typename compare, int arity>
+void PriorityQueue<keytype, valuetype, compare, arity>::addPadding() {
+    for (int i = 0; i < root; ++i) {
+        entries.AddEnd(Entry{keytype(), -1});
+    }
+}
+
+// Moves v into a free slot and returns the slot
+template <typename keytype, typename valuetype, typename compare, int arity>
+int PriorityQueue<keytype, valuetype, compare, arity>::store(valuetype v) {
+    if (freeSlots.Length() > 0) {
+        int slot = freeSlots[freeSlots.Length() - 1];
+        freeSlots.DelEnd();
+        values.Segments().first[slot].value = std::move(v);
+
+        return slot;
+    }
+
+    values.AddEnd(Payload{std::move(v)});
+
+    return values.Length() - 1;
+}
+
+// Throws if the queue is empty
+template <typename keytype, typename valuetype, typename compare, int arity>
+typename PriorityQueue<keytype, valuetype, compare, arity>::Entry & PriorityQueue<keytype, valuetype, compare, arity>::top() {
+    if (empty()) {
+        throw (std::string) "PQE1";
+    }
+
+    return entries.Segments().first[root];
+}
+
+template <typename keytype, typename valuetype, typename compare, int arity>
+PriorityQueue<keytype, valuetype, compare, arity>::PriorityQueue(compare c) : before(c) {
+    addPadding();
+}
+
+template <typename keytype, typename valuetype, typename compare, int arity>
+PriorityQueue<keytype, valuetype, compare, arity>::PriorityQueue(Element<keytype, valuetype> e[], int s, compare c) : before(c) {
+    // Heapify
+
+    addPadding();
+
+    for (int i = 0; i < s; ++i) {
+        entries.AddEnd(Entry{e[i].key, store(e[i].value)});
+    }
+
+    // Only nodes up to the parent of the last one have children
+    if (s > 1) {
+        for (int i = parent(entries.Length() - 1); i >= root; --i) {
+            percolateDown(i);
+        }
+    }
+}
+
+template <typename keytype, typename valuetype, typename compare, int arity>
+int PriorityQueue<keytype, valuetype, compare, arity>::size() {
+    return entries.Length() - root;
+}
+
+template <typename keytype, typename valuetype, typename compare, int arity>
+bool PriorityQueue<keytype, valuetype, compare, arity>::empty() {
+    return size() == 0;
+}
+
+template <typename keytype, typename valuetype, typename compare, int arity>
+keytype PriorityQueue<keytype, valuetype, compare, arity>::peekKey() {
+    return top().key;
+}
+
+template <typename keytype, typename valuetype, typename compare, int arity>
+valuetype PriorityQueue<keytype, valuetype, compare, arity>::peekValue() {
+    return values.Segments().first[top().slot].value;
+}
+
+// Removes and returns the entry that comes first under compare
+template <typename keytype, typename valuetype, typename compare, int arity>
+Element<keytype, valuetype> PriorityQueue<keytype, valuetype, compare, arity>::extractMin() {
+    Entry & first = top();
+    Element<keytype, valuetype> min{std::move(first.key), std::move(values.Segments().first[first.slot].value)};
+    freeSlots.AddEnd(first.slot);
+    removeAt(entries, root, EntryOrder{before}, [](const Entry &, int) {});
+
+    return min;
+}
+
+template <typename keytype, typename valuetype, typename compare, int arity>
+void PriorityQueue<keytype, valuetype, compare, arity>::insert(keytype k, valuetype v) {
+    entries.AddEnd(Entry{std::move(k), store(std::move(v))});
+    percolateUp(entries.Length() - 1);
+}
+
+#endif
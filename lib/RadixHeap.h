@@ -0,0 +1,182 @@
+/*
+ * Implements a radix heap for monotone unsigned integer keys.
+ *
+ * Keys may never be smaller than the last key extracted, which holds for
+ * timer queues and for Dijkstra's algorithm with non-negative weights.
+ * In exchange, insert takes O(1) time and extractMin takes O(log C)
+ * amortized time, where C is the largest key, with no comparisons of
+ * keys against each other while inserting.
+ * It has the same insert, peekKey and extractMin as Heap.
+ *
+ * Keys are kept in buckets by the highest bit in which they differ from
+ * the last key extracted. Bucket 0 holds keys equal to it, and bucket b
+ * holds keys whose highest differing bit is bit b - 1. When extractMin
+ * finds bucket 0 empty, the first non-empty bucket is emptied: its
+ * smallest key becomes the last key, and its keys move down to lower
+ * buckets. A key only ever moves down, so each one moves at most once per
+ * bit. peekKey only finds that smallest key, and remembers it.
+*/
+
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+#include "CDA.h"
+#include <string>
+#include <type_traits>
+
+template <typename keytype>
+class RadixHeap {
+    static_assert(std::is_integral<keytype>::value && std::is_unsigned<keytype>::value, "RadixHeap keys must be unsigned integers");
+
+    private:
+        static const int numBuckets = 8 * sizeof(keytype) + 1;
+
+        CDA<keytype> buckets[numBuckets];
+        keytype last;
+        int count;
+
+        // The smallest key, once peekKey has looked for it in a bucket
+        // other than 0. Only extractMin moves keys between buckets.
+        keytype minimum;
+        bool minimumKnown;
+
+        int bucketOf(keytype k) const;
+        int firstBucket();
+        void findMinimum(int b);
+
+    public:
+        RadixHeap();
+        int size();
+        bool empty();
+        keytype peekKey();
+        keytype extractMin();
+        void insert(keytype k);
+};
+
+// One more than the index of the highest bit in which k differs from last
+template <typename keytype>
+int RadixHeap<keytype>::bucketOf(keytype k) const {
+    unsigned long long difference = k ^ last;
+
+    return (difference == 0) ? 0 : 64 - __builtin_clzll(difference);
+}
+
+// Returns the first non-empty bucket. Throws if the heap is empty.
+template <typename keytype>
+int RadixHeap<keytype>::firstBucket() {
+    if (count == 0) {
+        throw (std::string) "RHE1";
+    }
+
+    int b = 0;
+
+    while (buckets[b].Length() == 0) {
+        ++b;
+    }
+
+    return b;
+}
+
+// Finds the smallest key in bucket b, unless it is already known
+template <typename keytype>
+void RadixHeap<keytype>::findMinimum(int b) {
+    if (minimumKnown) {
+        return;
+    }
+
+    keytype* keys = buckets[b].Segments().first;
+    int length = buckets[b].Length();
+    minimum = keys[0];
+
+    for (int i = 1; i < length; ++i) {
+        if (keys[i] < minimum) {
+            minimum = keys[i];
+        }
+    }
+
+    minimumKnown = true;
+}
+
+template <typename keytype>
+RadixHeap<keytype>::RadixHeap() : last(0), count(0), minimum(0), minimumKnown(false) {
+    // Buckets fill and empty over and over, so they keep their capacity
+    GrowthPolicy policy;
+    policy.neverShrink = true;
+
+    for (int b = 0; b < numBuckets; ++b) {
+        buckets[b].SetGrowthPolicy(policy);
+    }
+}
+
+template <typename keytype>
+int RadixHeap<keytype>::size() {
+    return count;
+}
+
+template <typename keytype>
+bool RadixHeap<keytype>::empty() {
+    return count == 0;
+}
+
+// Leaves the buckets alone, so a later insert may still go below the key
+// returned, down to the last key extracted
+template <typename keytype>
+keytype RadixHeap<keytype>::peekKey() {
+    int b = firstBucket();
+
+    if (b == 0) {
+        return last;
+    }
+
+    findMinimum(b);
+
+    return minimum;
+}
+
+template <typename keytype>
+keytype RadixHeap<keytype>::extractMin() {
+    // If bucket 0 is empty, empty the first non-empty bucket instead. Its
+    // smallest key becomes the new last key. Every key in the bucket shares
+    // bits above b - 1 with it, so they all land in lower buckets.
+
+    int b = firstBucket();
+
+    if (b > 0) {
+        findMinimum(b);
+        last = minimum;
+
+        keytype* keys = buckets[b].Segments().first;
+        int length = buckets[b].Length();
+
+        for (int i = 0; i < length; ++i) {
+            buckets[bucketOf(keys[i])].AddEnd(keys[i]);
+        }
+
+        while (buckets[b].Length() > 0) {
+            buckets[b].DelEnd();
+        }
+    }
+
+    minimumKnown = false;
+    buckets[0].DelEnd();
+    --count;
+
+    return last;
+}
+
+// Throws if k is smaller than the last key extracted
+template <typename keytype>
+void RadixHeap<keytype>::insert(keytype k) {
+    if (k < last) {
+        throw (std::string) "RHI1";
+    }
+
+    buckets[bucketOf(k)].AddEnd(k);
+    ++count;
+
+    if (minimumKnown && k < minimum) {
+        minimum = k;
+    }
+}
+
+#endif
@@ -0,0 +1,228 @@
+/*
+ * Implements a bounded lock-free single-producer/single-consumer queue.
+ *
+ * It is a circular array like CDA, except that the front and back are
+ * two ever-increasing counters instead of a front index and a size.
+ * The producer only writes the tail and the consumer only writes the
+ * head, so one acquire/release pair per operation is all the
+ * synchronization it needs. Each side keeps its own counter and a cached
+ * copy of the other side's counter on a separate cache line, so the two
+ * threads only share a line when one of them runs out of room or work.
+ *
+ * The capacity is rounded up to a power of two so a counter maps to a
+ * slot with a mask (see MaskIndexing in CDA.h). Exactly one thread may
+ * push and exactly one thread may pop at a time.
+*/
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include "CDA.h"
+#include <atomic>
+#include <new>
+#include <string>
+#include <utility>
+
+template <typename elmtype>
+class SPSCQueue {
+    private:
+        static const int cacheLineSize = 64;
+
+        // Read by both threads, never written after construction
+        alignas(cacheLineSize) int capacity;
+        elmtype* array;
+
+        // Written by the producer
+        alignas(cacheLineSize) std::atomic<long long> tail;
+        long long cachedHead;
+
+        // Written by the consumer
+        alignas(cacheLineSize) std::atomic<long long> head;
+        long long cachedTail;
+
+        elmtype & GetSlot(long long i);
+        bool HasRoom(long long t, int count);
+        int Available(long long h);
+
+    public:
+        SPSCQueue(int s);
+        ~SPSCQueue();
+        SPSCQueue(const SPSCQueue & source) = delete;
+        SPSCQueue & operator =(const SPSCQueue & source) = delete;
+        bool TryPush(const elmtype & v);
+        bool TryPush(elmtype && v);
+        template <typename... argtypes>
+        bool TryEmplace(argtypes&&... args);
+        bool TryPop(elmtype & v);
+        int PushBatch(const elmtype items[], int count);
+        int PopBatch(elmtype items[], int count);
+        int Length() const;
+        int Capacity() const;
+        bool Empty() const;
+};
+
+// Makes a queue that holds at least s elements
+template <typename elmtype>
+SPSCQueue<elmtype>::SPSCQueue(int s) : capacity(MaskIndexing::RoundCapacity(s)), tail(0), cachedHead(0), head(0), cachedTail(0) {
+    if (s < 1) {
+        throw (std::string) "SQC1";
+    }
+
+    array = static_cast<elmtype*>(::operator new(capacity * sizeof(elmtype), std::align_val_t(alignof(elmtype))));
+}
+
+template <typename elmtype>
+SPSCQueue<elmtype>::~SPSCQueue() {
+    long long t = tail.load(std::memory_order_relaxed);
+
+    for (long long h = head.load(std::memory_order_relaxed); h < t; ++h) {
+        GetSlot(h).~elmtype();
+    }
+
+    ::operator delete(array, std::align_val_t(alignof(elmtype)));
+}
+
+template <typename elmtype>
+bool SPSCQueue<elmtype>::TryPush(const elmtype & v) {
+    return TryEmplace(v);
+}
+
+template <typename elmtype>
+bool SPSCQueue<elmtype>::TryPush(elmtype && v) {
+    return TryEmplace(std::move(v));
+}
+
+// Builds an element at the back from args. Returns false if the queue is full.
+template <typename elmtype>
+template <typename... argtypes>
+bool SPSCQueue<elmtype>::TryEmplace(argtypes&&... args) {
+    long long t = tail.load(std::memory_order_relaxed);
+
+    if (!HasRoom(t, 1)) {
+        return false;
+    }
+
+    new (&GetSlot(t)) elmtype(std::forward<argtypes>(args)...);
+    tail.store(t + 1, std::memory_order_release);
+
+    return true;
+}
+
+// Moves the front element into v. Returns false if the queue is empty.
+template <typename elmtype>
+bool SPSCQueue<elmtype>::TryPop(elmtype & v) {
+    long long h = head.load(std::memory_order_relaxed);
+
+    if (Available(h) == 0) {
+        return false;
+    }
+
+    v = std::move(GetSlot(h));
+    GetSlot(h).~elmtype();
+    head.store(h + 1, std::memory_order_release);
+
+    return true;
+}
+
+// Pushes as many of the count items as fit and publishes them all at once.
+// Returns how many were pushed.
+template <typename elmtype>
+int SPSCQueue<elmtype>::PushBatch(const elmtype items[], int count) {
+    if (count <= 0) {
+        return 0;
+    }
+
+    long long t = tail.load(std::memory_order_relaxed);
+
+    if (!HasRoom(t, count)) {
+        count = capacity - (t - cachedHead);
+    }
+
+    for (int i = 0; i < count; ++i) {
+        new (&GetSlot(t + i)) elmtype(items[i]);
+    }
+
+    if (count > 0) {
+        tail.store(t + count, std::memory_order_release);
+    }
+
+    return count;
+}
+
+// Pops up to count elements into items and frees their slots all at once.
+// Returns how many were popped.
+template <typename elmtype>
+int SPSCQueue<elmtype>::PopBatch(elmtype items[], int count) {
+    if (count <= 0) {
+        return 0;
+    }
+
+    long long h = head.load(std::memory_order_relaxed);
+    int available = Available(h);
+
+    if (count > available) {
+        cachedTail = tail.load(std::memory_order_acquire);
+        available = cachedTail - h;
+    }
+
+    if (count > available) {
+        count = available;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        items[i] = std::move(GetSlot(h + i));
+        GetSlot(h + i).~elmtype();
+    }
+
+    if (count > 0) {
+        head.store(h + count, std::memory_order_release);
+    }
+
+    return count;
+}
+
+// Only exact when neither thread is running
+template <typename elmtype>
+int SPSCQueue<elmtype>::Length() const {
+    // Reading head first means the result is never negative
+    long long h = head.load(std::memory_order_acquire);
+    return tail.load(std::memory_order_acquire) - h;
+}
+
+template <typename elmtype>
+int SPSCQueue<elmtype>::Capacity() const {
+    return capacity;
+}
+
+template <typename elmtype>
+bool SPSCQueue<elmtype>::Empty() const {
+    return Length() <= 0;
+}
+
+template <typename elmtype>
+elmtype & SPSCQueue<elmtype>::GetSlot(long long i) {
+    return array[i & (capacity - 1)];
+}
+
+// Producer side. Only rereads the consumer's counter when the cached one says the queue is full.
+template <typename elmtype>
+bool SPSCQueue<elmtype>::HasRoom(long long t, int count) {
+    if (t - cachedHead + count <= capacity) {
+        return true;
+    }
+
+    cachedHead = head.load(std::memory_order_acquire);
+    return t - cachedHead + count <= capacity;
+}
+
+// Consumer side. Only rereads the producer's counter when the cached one says the queue is empty.
+template <typename elmtype>
+int SPSCQueue<elmtype>::Available(long long h) {
+    if (cachedTail == h) {
+        cachedTail = tail.load(std::memory_order_acquire);
+    }
+
+    return cachedTail - h;
+}
+
+#endif
@@ -0,0 +1,193 @@
+/*
+ * Implements a lock-free work-stealing deque (Chase and Lev).
+ *
+ * One owner thread pushes and pops at the bottom like a stack, while any
+ * number of thieves steal from the top. Like CDA, it is a circular array
+ * indexed by two ever-increasing counters. The owner only competes with
+ * thieves for the last element, which is settled with a compare-and-swap
+ * on the top counter. A thief that loses a race just reports failure.
+ *
+ * When the owner runs out of room it copies the live elements into a
+ * buffer twice as large. A thief may still be reading the old buffer,
+ * so retired buffers are kept until the deque is destroyed. Their total
+ * size never exceeds the size of the current buffer.
+ *
+ * Slots are read by thieves while the owner may be writing them, so they
+ * are atomics, and elements must be trivially copyable. Pointers to tasks
+ * are the usual choice.
+*/
+
+#ifndef WORK_STEALING_DEQUE_H
+#define WORK_STEALING_DEQUE_H
+
+#include "CDA.h"
+#include <atomic>
+#include <string>
+#include <type_traits>
+
+template <typename elmtype>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable<elmtype>::value, "WorkStealingDeque elements must be trivially copyable");
+
+    private:
+        static const int cacheLineSize = 64;
+
+        struct Buffer {
+            int capacity;
+            std::atomic<elmtype>* slots;
+
+            Buffer(int s) : capacity(s), slots(new std::atomic<elmtype>[s]) {}
+            ~Buffer() { delete[] slots; }
+
+            elmtype Get(long long i) const {
+                return slots[i & (capacity - 1)].load(std::memory_order_relaxed);
+            }
+
+            void Put(long long i, const elmtype & v) {
+                slots[i & (capacity - 1)].store(v, std::memory_order_relaxed);
+            }
+        };
+
+        // Written by thieves, and by the owner when it takes the last element
+        alignas(cacheLineSize) std::atomic<long long> top;
+
+        // Written only by the owner
+        alignas(cacheLineSize) std::atomic<long long> bottom;
+        std::atomic<Buffer*> buffer;
+        CDA<Buffer*> retired;
+
+        Buffer* Grow(Buffer* old, long long t, long long b);
+
+    public:
+        WorkStealingDeque(int s = 64);
+        ~WorkStealingDeque();
+        WorkStealingDeque(const WorkStealingDeque & source) = delete;
+        WorkStealingDeque & operator =(const WorkStealingDeque & source) = delete;
+        void Push(const elmtype & v);
+        bool TryPop(elmtype & v);
+        bool TrySteal(elmtype & v);
+        int Length() const;
+        int Capacity() const;
+        bool Empty() const;
+};
+
+// Makes a deque whose first buffer holds at least s elements
+template <typename elmtype>
+WorkStealingDeque<elmtype>::WorkStealingDeque(int s) : top(0), bottom(0) {
+    if (s < 1) {
+        throw (std::string) "WDC1";
+    }
+
+    buffer.store(new Buffer(MaskIndexing::RoundCapacity(s)), std::memory_order_relaxed);
+}
+
+template <typename elmtype>
+WorkStealingDeque<elmtype>::~WorkStealingDeque() {
+    delete buffer.load(std::memory_order_relaxed);
+
+    for (int i = 0; i < retired.Length(); ++i) {
+        delete retired[i];
+    }
+}
+
+// Owner only. Adds v at the bottom, growing the buffer if it is full.
+template <typename elmtype>
+void WorkStealingDeque<elmtype>::Push(const elmtype & v) {
+    long long b = bottom.load(std::memory_order_relaxed);
+    long long t = top.load(std::memory_order_acquire);
+    Buffer* current = buffer.load(std::memory_order_relaxed);
+
+    if (b - t >= current->capacity) {
+        current = Grow(current, t, b);
+    }
+
+    current->Put(b, v);
+    bottom.store(b + 1, std::memory_order_release);
+}
+
+// Owner only. Takes the element at the bottom, the one pushed most recently.
+// Returns false if the deque is empty or a thief took the last element first.
+template <typename elmtype>
+bool WorkStealingDeque<elmtype>::TryPop(elmtype & v) {
+    long long b = bottom.load(std::memory_order_relaxed) - 1;
+    Buffer* current = buffer.load(std::memory_order_relaxed);
+
+    // Claim the bottom slot before looking at top, so a thief that reads
+    // bottom after this cannot take it too
+    bottom.store(b, std::memory_order_seq_cst);
+    long long t = top.load(std::memory_order_seq_cst);
+
+    if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    v = current->Get(b);
+
+    if (t < b) {
+        return true;
+    }
+
+    // Last element, so race the thieves for it
+    bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_relaxed);
+
+    return won;
+}
+
+// Any thread. Takes the element at the top, the oldest one.
+// Returns false if the deque is empty or another thread took it first.
+template <typename elmtype>
+bool WorkStealingDeque<elmtype>::TrySteal(elmtype & v) {
+    long long t = top.load(std::memory_order_seq_cst);
+    long long b = bottom.load(std::memory_order_seq_cst);
+
+    if (t >= b) {
+        return false;
+    }
+
+    elmtype stolen = buffer.load(std::memory_order_acquire)->Get(t);
+
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return false;
+    }
+
+    v = stolen;
+    return true;
+}
+
+// Only exact when no thread is running
+template <typename elmtype>
+int WorkStealingDeque<elmtype>::Length() const {
+    long long t = top.load(std::memory_order_acquire);
+    long long b = bottom.load(std::memory_order_acquire);
+    return (b > t) ? b - t : 0;
+}
+
+template <typename elmtype>
+int WorkStealingDeque<elmtype>::Capacity() const {
+    return buffer.load(std::memory_order_acquire)->capacity;
+}
+
+template <typename elmtype>
+bool WorkStealingDeque<elmtype>::Empty() const {
+    return Length() == 0;
+}
+
+// Copies the elements from t up to b into a buffer twice the size and
+// publishes it. The old buffer is retired rather than freed.
+template <typename elmtype>
+typename WorkStealingDeque<elmtype>::Buffer* WorkStealingDeque<elmtype>::Grow(Buffer* old, long long t, long long b) {
+    Buffer* bigger = new Buffer(old->capacity * 2);
+
+    for (long long i = t; i < b; ++i) {
+        bigger->Put(i, old->Get(i));
+    }
+
+    retired.AddEnd(old);
+    buffer.store(bigger, std::memory_order_release);
+
+    return bigger;
+}
+
+#endif
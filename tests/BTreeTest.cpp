@@ -0,0 +1,427 @@
+#include "BTree.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    // Checks key counts, ordering, subtree sizes, parent pointers and that
+    // every leaf is at the same depth. Returns the depth of the leaves.
+    template <typename keytype, typename valuetype, int order>
+    int checkInvariants(Node<keytype, valuetype, order>* node, bool isRoot) {
+        if (!isRoot) {
+            EXPECT_GE(node->getNumElements(), order / 2 - 1);
+        }
+
+        EXPECT_LE(node->getNumElements(), order - 1);
+
+        for (int i = 1; i < node->getNumElements(); ++i) {
+            EXPECT_FALSE(node->getKey(i) < node->getKey(i - 1));
+        }
+
+        int size = node->getNumElements();
+        int depth = 0;
+
+        if (node->getNumChildren() > 0) {
+            EXPECT_EQ(node->getNumChildren(), node->getNumElements() + 1);
+
+            for (int i = 0; i < node->getNumChildren(); ++i) {
+                Node<keytype, valuetype, order>* child = node->getChild(i);
+                EXPECT_EQ(child->getParent(), node);
+
+                int childDepth = checkInvariants<keytype, valuetype, order>(child, false);
+
+                if (i == 0) {
+                    depth = childDepth + 1;
+                }
+
+                else {
+                    EXPECT_EQ(childDepth + 1, depth);
+                }
+
+                size += child->getSize();
+            }
+        }
+
+        EXPECT_EQ(node->getSize(), size);
+
+        return depth;
+    }
+
+    template <int order>
+    void randomOperations() {
+        BTree<int, int, order> t;
+        std::vector<int> keys;
+        std::mt19937 rng(order);
+
+        int inputSize = 5000;
+
+        for (int i = 0; i < inputSize; ++i) {
+            keys.push_back(i * 2);
+        }
+
+        std::shuffle(keys.begin(), keys.end(), rng);
+
+        for (int i = 0; i < inputSize; ++i) {
+            t.insert(keys[i], keys[i] * 10);
+            EXPECT_EQ(t.size(), i + 1);
+        }
+
+        checkInvariants(t.getRoot(), true);
+
+        for (int i = 0; i < inputSize; ++i) {
+            EXPECT_EQ(*t.search(i * 2), i * 20);
+            EXPECT_EQ(t.search(i * 2 + 1), nullptr);
+            EXPECT_EQ(t.rank(i * 2), i + 1);
+            EXPECT_EQ(t.select(i + 1), i * 2);
+        }
+
+        for (int i = 1; i < inputSize - 1; ++i) {
+            EXPECT_EQ(t.successor(i * 2), i * 2 + 2);
+            EXPECT_EQ(t.predecessor(i * 2), i * 2 - 2);
+        }
+
+        std::shuffle(keys.begin(), keys.end(), rng);
+
+        for (int i = 0; i < inputSize / 2; ++i) {
+            EXPECT_EQ(t.remove(keys[i]), 1);
+            EXPECT_EQ(t.remove(keys[i]), 0);
+        }
+
+        EXPECT_EQ(t.size(), inputSize - inputSize / 2);
+        checkInvariants(t.getRoot(), true);
+
+        std::vector<int> remaining(keys.begin() + inputSize / 2, keys.end());
+        std::sort(remaining.begin(), remaining.end());
+
+        std::ostringstream expectedInorder;
+        for (int k : remaining) {
+            expectedInorder << k << ' ';
+        }
+
+        std::string expectedInorderString = expectedInorder.str();
+        expectedInorderString.pop_back();
+
+        EXPECT_EQ(t.inorderString(), expectedInorderString);
+
+        for (int i = 0; i < (int) remaining.size(); ++i) {
+            EXPECT_EQ(t.select(i + 1), remaining[i]);
+        }
+
+        for (int i = inputSize / 2; i < inputSize; ++i) {
+            EXPECT_EQ(t.remove(keys[i]), 1);
+        }
+
+        EXPECT_EQ(t.size(), 0);
+        EXPECT_EQ(t.getRoot()->getNumChildren(), 0);
+        EXPECT_EQ(t.getPool().getLiveNodes(), 1);
+    }
+
+    template <int order>
+    void collectElements(Node<int, int, order>* node, std::vector<std::pair<int, int>> & elements) {
+        for (int i = 0; i < node->getNumElements(); ++i) {
+            if (node->getNumChildren() > 0) {
+                collectElements(node->getChild(i), elements);
+            }
+
+            elements.push_back(std::make_pair(node->getKey(i), node->getValue(i)));
+        }
+
+        if (node->getNumChildren() > 0) {
+            collectElements(node->getRightmostChild(), elements);
+        }
+    }
+
+    template <int order>
+    void bulkLoad() {
+        for (int inputSize = 0; inputSize < 600; inputSize += (inputSize < 100) ? 1 : 37) {
+            int* keys = new int[inputSize];
+            int* values = new int[inputSize];
+
+            for (int i = 0; i < inputSize; ++i) {
+                keys[i] = i * 2;
+                values[i] = i;
+            }
+
+            BTree<int, int, order> t(keys, values, inputSize, true);
+            EXPECT_EQ(t.size(), inputSize);
+            checkInvariants(t.getRoot(), true);
+
+            for (int i = 0; i < inputSize; ++i) {
+                EXPECT_EQ(*t.search(i * 2), i);
+                EXPECT_EQ(t.rank(i * 2), i + 1);
+                EXPECT_EQ(t.select(i + 1), i * 2);
+            }
+
+            // The packed tree must still accept inserts and removals
+            for (int i = 0; i < inputSize; ++i) {
+                t.insert(i * 2 + 1, i);
+            }
+
+            checkInvariants(t.getRoot(), true);
+
+            for (int i = 0; i < inputSize; ++i) {
+                EXPECT_EQ(t.remove(i * 2), 1);
+            }
+
+            EXPECT_EQ(t.size(), inputSize);
+            checkInvariants(t.getRoot(), true);
+
+            delete[] keys;
+            delete[] values;
+        }
+    }
+
+    TEST(BTreeTest, bulkLoadOrder4) {
+        bulkLoad<4>();
+    }
+
+    TEST(BTreeTest, bulkLoadOrder6) {
+        bulkLoad<6>();
+    }
+
+    TEST(BTreeTest, bulkLoadOrder32) {
+        bulkLoad<32>();
+    }
+
+    TEST(BTreeTest, bulkLoadHeight) {
+        int inputSize = 100000;
+        int* keys = new int[inputSize];
+
+        for (int i = 0; i < inputSize; ++i) {
+            keys[i] = i;
+        }
+
+        BTree<int, int, 32> t(keys, keys, inputSize, true);
+
+        // 32^3 = 32768 < 100000 <= 32^4, so four levels
+        EXPECT_EQ(checkInvariants(t.getRoot(), true), 3);
+
+        delete[] keys;
+    }
+
+    TEST(BTreeTest, bulkLoadUnsorted) {
+        int inputSize = 3000;
+        int keys[inputSize];
+        int values[inputSize];
+        std::mt19937 rng(6);
+
+        for (int i = 0; i < inputSize; ++i) {
+            keys[i] = rng() % 500;
+            values[i] = i;
+        }
+
+        BTree<int, int, 8> t(keys, values, inputSize, false);
+        EXPECT_EQ(t.size(), inputSize);
+        checkInvariants(t.getRoot(), true);
+
+        std::vector<std::pair<int, int>> expected;
+        for (int i = 0; i < inputSize; ++i) {
+            expected.push_back(std::make_pair(keys[i], values[i]));
+        }
+
+        std::stable_sort(expected.begin(), expected.end(), [](const std::pair<int, int> & p1, const std::pair<int, int> & p2) {
+            return p1.first < p2.first;
+        });
+
+        for (int i = 0; i < inputSize; ++i) {
+            EXPECT_EQ(t.select(i + 1), expected[i].first);
+        }
+
+        // Equal keys keep their input order
+        std::vector<std::pair<int, int>> actual;
+        collectElements(t.getRoot(), actual);
+        EXPECT_EQ(actual, expected);
+    }
+
+    TEST(BTreeTest, order4) {
+        randomOperations<4>();
+    }
+
+    TEST(BTreeTest, order6) {
+        randomOperations<6>();
+    }
+
+    TEST(BTreeTest, order16) {
+        randomOperations<16>();
+    }
+
+    TEST(BTreeTest, order32) {
+        randomOperations<32>();
+    }
+
+    TEST(BTreeTest, order64) {
+        randomOperations<64>();
+    }
+
+    TEST(BTreeTest, height) {
+        BTree<int, int, 32> t;
+
+        int inputSize = 100000;
+
+        for (int i = 0; i < inputSize; ++i) {
+            t.insert(i, i);
+        }
+
+        // log base 16 of 100000 is about 4.2
+        EXPECT_LE(checkInvariants(t.getRoot(), true), 5);
+    }
+
+    TEST(BTreeTest, duplicateKeys) {
+        BTree<int, int, 8> t;
+
+        int inputSize = 2000;
+
+        for (int i = 0; i < inputSize; ++i) {
+            t.insert(i % 3, i);
+        }
+
+        checkInvariants(t.getRoot(), true);
+        EXPECT_EQ(t.size(), inputSize);
+
+        for (int i = 0; i < inputSize; ++i) {
+            EXPECT_EQ(t.select(i + 1), i * 3 / inputSize);
+        }
+    }
+
+    TEST(BTreeTest, copyConstructor) {
+        BTree<std::string, int, 16> t1;
+
+        int inputSize = 1000;
+
+        for (int i = 0; i < inputSize; ++i) {
+            t1.insert(std::to_string(i), i);
+        }
+
+        BTree<std::string, int, 16> t2(t1);
+        EXPECT_NE(t1.getRoot(), t2.getRoot());
+        EXPECT_EQ(t1.inorderString(), t2.inorderString());
+        EXPECT_EQ(t1.preorderString(), t2.preorderString());
+
+        for (int i = 0; i < inputSize; ++i) {
+            t1.remove(std::to_string(i));
+        }
+
+        EXPECT_EQ(t2.size(), inputSize);
+        checkInvariants(t2.getRoot(), true);
+    }
+
+    TEST(BTreeTest, iterators) {
+        BTree<int, int, 6> t;
+
+        EXPECT_TRUE(t.begin() == t.end());
+
+        int inputSize = 3000;
+        std::vector<int> keys;
+
+        for (int i = 0; i < inputSize; ++i) {
+            keys.push_back(i * 2);
+        }
+
+        std::mt19937 rng(7);
+        std::shuffle(keys.begin(), keys.end(), rng);
+
+        for (int k : keys) {
+            t.insert(k, k + 1);
+        }
+
+        int expected = 0;
+        for (BTree<int, int, 6>::iterator it = t.begin(); it != t.end(); ++it) {
+            EXPECT_EQ((*it).key, expected);
+            EXPECT_EQ((*it).value, expected + 1);
+            expected += 2;
+        }
+
+        EXPECT_EQ(expected, inputSize * 2);
+        EXPECT_EQ(std::distance(t.begin(), t.end()), inputSize);
+
+        BTree<int, int, 6>::iterator it = t.end();
+        for (int i = inputSize - 1; i >= 0; --i) {
+            --it;
+            EXPECT_EQ(it.getKey(), i * 2);
+        }
+
+        EXPECT_TRUE(it == t.begin());
+
+        // Values can be changed through an iterator
+        for (auto element : t) {
+            element.value = -element.key;
+        }
+
+        EXPECT_EQ(*t.search(10), -10);
+    }
+
+    TEST(BTreeTest, bounds) {
+        BTree<int, int, 4> t;
+
+        for (int i = 0; i < 1000; ++i) {
+            t.insert(i * 3, i);
+        }
+
+        for (int k = -2; k < 3000; ++k) {
+            BTree<int, int, 4>::iterator lower = t.lower_bound(k);
+            BTree<int, int, 4>::iterator upper = t.upper_bound(k);
+            int expectedLower = (k <= 0) ? 0 : (k + 2) / 3 * 3;
+            int expectedUpper = (k < 0) ? 0 : k / 3 * 3 + 3;
+
+            if (expectedLower < 3000) {
+                EXPECT_EQ(lower.getKey(), expectedLower);
+            }
+
+            else {
+                EXPECT_TRUE(lower == t.end());
+            }
+
+            if (expectedUpper < 3000) {
+                EXPECT_EQ(upper.getKey(), expectedUpper);
+            }
+
+            else {
+                EXPECT_TRUE(upper == t.end());
+            }
+        }
+    }
+
+    TEST(BTreeTest, boundsWithDuplicates) {
+        BTree<int, int, 8> t;
+
+        for (int i = 0; i < 900; ++i) {
+            t.insert(i % 3, i);
+        }
+
+        EXPECT_EQ(std::distance(t.begin(), t.lower_bound(1)), 300);
+        EXPECT_EQ(std::distance(t.begin(), t.upper_bound(1)), 600);
+        EXPECT_EQ(std::distance(t.lower_bound(2), t.end()), 300);
+        EXPECT_TRUE(t.upper_bound(2) == t.end());
+    }
+
+    TEST(BTreeTest, rangeScan) {
+        BTree<std::string, int, 16> t;
+
+        for (int i = 0; i < 1000; ++i) {
+            t.insert(std::to_string(i), i);
+        }
+
+        std::vector<int> scanned;
+        t.rangeScan("2", "3", [&scanned](const std::string & k, int & v) {
+            EXPECT_EQ(k, std::to_string(v));
+            scanned.push_back(v);
+        });
+
+        // "2", "20" to "29" and "200" to "299"
+        EXPECT_EQ(scanned.size(), 111u);
+
+        for (int i = 1; i < (int) scanned.size(); ++i) {
+            EXPECT_LT(std::to_string(scanned[i - 1]), std::to_string(scanned[i]));
+        }
+
+        int count = 0;
+        t.rangeScan("5", "5", [&count](const std::string &, int &) {
+            ++count;
+        });
+
+        EXPECT_EQ(count, 0);
+    }
+}
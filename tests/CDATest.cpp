@@ -1,5 +1,12 @@
 #include "CDA.h"
+#include "Element.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <limits>
 #include <string>
+#include <utility>
+#include <vector>
 #include <gtest/gtest.h>
 
 namespace {
@@ -50,4 +57,748 @@ namespace {
         EXPECT_EQ(cCopy.Length(), 3);
         EXPECT_EQ(c1.Length(), 5);
     }
+
+    // Counts how often elements are copied rather than moved
+    struct CopyCounter {
+        static int copies;
+        int id;
+
+        CopyCounter() : id(0) {}
+        CopyCounter(int i) : id(i) {}
+        CopyCounter(const CopyCounter & other) : id(other.id) { ++copies; }
+        CopyCounter(CopyCounter && other) noexcept : id(other.id) {}
+        CopyCounter & operator=(const CopyCounter & other) { id = other.id; ++copies; return *this; }
+        CopyCounter & operator=(CopyCounter && other) noexcept { id = other.id; return *this; }
+        bool operator<(const CopyCounter & other) const { return id < other.id; }
+        bool operator>(const CopyCounter & other) const { return id > other.id; }
+    };
+
+    int CopyCounter::copies = 0;
+
+    TEST_F(CDATest, copyConstructorWrapped) {
+        for (int i = 0; i < 4; ++i) {
+            c1.AddEnd(i);
+        }
+
+        // Wrap the front around to the end of the buffer
+        c1.DelFront();
+        c1.DelFront();
+        c1.AddEnd(4);
+        c1.AddEnd(5);
+
+        CDA<int> cCopy(c1);
+        ASSERT_EQ(cCopy.Length(), 4);
+
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_EQ(cCopy[i], i + 2);
+        }
+    }
+
+    TEST_F(CDATest, moveConstructor) {
+        CDA<std::string> c2;
+
+        for (int i = 0; i < 100; ++i) {
+            c2.AddEnd(std::to_string(i));
+        }
+
+        CDA<std::string> c3(std::move(c2));
+        EXPECT_EQ(c3.Length(), 100);
+        EXPECT_EQ(c3[99], "99");
+        EXPECT_EQ(c2.Length(), 0);
+
+        // A moved-from array can be reused
+        c2.AddEnd("a");
+        c2.AddFront("b");
+        EXPECT_EQ(c2.Length(), 2);
+        EXPECT_EQ(c2[0], "b");
+
+        c2 = std::move(c3);
+        EXPECT_EQ(c2.Length(), 100);
+        EXPECT_EQ(c2[0], "0");
+    }
+
+    TEST_F(CDATest, emplace) {
+        CDA<std::string> c2;
+
+        EXPECT_EQ(c2.EmplaceEnd(3, 'x'), "xxx");
+        EXPECT_EQ(c2.EmplaceFront("ab"), "ab");
+        c2.EmplaceEnd();
+
+        ASSERT_EQ(c2.Length(), 3);
+        EXPECT_EQ(c2[0], "ab");
+        EXPECT_EQ(c2[1], "xxx");
+        EXPECT_EQ(c2[2], "");
+
+        // Adding an element of the array to itself survives the resize
+        for (int i = 0; i < 20; ++i) {
+            c2.AddEnd(c2[1]);
+        }
+
+        EXPECT_EQ(c2[22], "xxx");
+    }
+
+    TEST_F(CDATest, growthMovesElements) {
+        CDA<CopyCounter> c2;
+        CopyCounter::copies = 0;
+
+        for (int i = 0; i < 1000; ++i) {
+            c2.AddEnd(CopyCounter(i));
+            c2.EmplaceFront(-i);
+        }
+
+        while (c2.Length() > 10) {
+            c2.DelEnd();
+        }
+
+        EXPECT_EQ(CopyCounter::copies, 0);
+        EXPECT_EQ(c2[0].id, -999);
+    }
+
+    // Has no default constructor, so it can only live in raw storage
+    struct NoDefault {
+        int id;
+
+        explicit NoDefault(int i) : id(i) {}
+        bool operator<(const NoDefault & other) const { return id < other.id; }
+        bool operator>(const NoDefault & other) const { return id > other.id; }
+    };
+
+    TEST_F(CDATest, reserveAndShrinkToFit) {
+        c1.Reserve(100);
+        EXPECT_EQ(c1.EmptySlots(), 100);
+
+        for (int i = 0; i < 10; ++i) {
+            c1.AddEnd(i);
+        }
+
+        EXPECT_EQ(c1.EmptySlots(), 90);
+
+        c1.ShrinkToFit();
+        EXPECT_EQ(c1.EmptySlots(), 0);
+
+        for (int i = 0; i < 10; ++i) {
+            EXPECT_EQ(c1[i], i);
+        }
+
+        // Reserve never shrinks
+        c1.Reserve(5);
+        EXPECT_EQ(c1.Length(), 10);
+        EXPECT_EQ(c1.EmptySlots(), 0);
+    }
+
+    TEST_F(CDATest, growWrapped) {
+        // Mix front and back inserts so the elements wrap around the
+        // buffer when it grows, for both the realloc and the move path
+        CDA<std::string> c2;
+
+        for (int i = 0; i < 1000; ++i) {
+            c1.AddFront(-i);
+            c1.AddEnd(i);
+            c2.AddFront(std::to_string(-i));
+            c2.AddEnd(std::to_string(i));
+        }
+
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_EQ(c1[999 - i], -i);
+            EXPECT_EQ(c1[1000 + i], i);
+            EXPECT_EQ(c2[999 - i], std::to_string(-i));
+            EXPECT_EQ(c2[1000 + i], std::to_string(i));
+        }
+
+        for (int i = 0; i < 1990; ++i) {
+            c1.DelFront();
+            c2.DelFront();
+        }
+
+        for (int i = 0; i < 10; ++i) {
+            EXPECT_EQ(c1[i], 990 + i);
+            EXPECT_EQ(c2[i], std::to_string(990 + i));
+        }
+    }
+
+    TEST_F(CDATest, noDefaultConstructor) {
+        CDA<NoDefault> c2;
+
+        for (int i = 0; i < 100; ++i) {
+            c2.EmplaceEnd(i);
+            c2.AddFront(NoDefault(-i));
+        }
+
+        c2.MergeSort();
+        EXPECT_EQ(c2[0].id, 99);
+        EXPECT_EQ(c2[199].id, -99);
+
+        CDA<NoDefault> c3(c2);
+        c3.DelEnd();
+        c3.ShrinkToFit();
+        EXPECT_EQ(c3.Length(), 199);
+        EXPECT_EQ(c3[198].id, -98);
+
+        EXPECT_THROW(c3[199], std::string);
+    }
+
+    TEST_F(CDATest, maskIndexing) {
+        CDA<int, MaskIndexing> c2(5);
+        EXPECT_EQ(c2.Length(), 5);
+        EXPECT_EQ(c2.EmptySlots(), 3);
+
+        c2.Reserve(9);
+        EXPECT_EQ(c2.EmptySlots(), 11);
+
+        for (int i = 0; i < 1000; ++i) {
+            c2.AddFront(-i);
+            c2.AddEnd(i);
+        }
+
+        // Every capacity is a power of two
+        EXPECT_EQ(c2.Length() + c2.EmptySlots(), 2048);
+
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_EQ(c2[999 - i], -i);
+            EXPECT_EQ(c2[1005 + i], i);
+        }
+
+        while (c2.Length() > 20) {
+            c2.DelFront();
+        }
+
+        EXPECT_EQ(c2.Length() + c2.EmptySlots(), 64);
+        EXPECT_EQ(c2[0], 980);
+        EXPECT_EQ(c2.Search(990), 10);
+        EXPECT_EQ(c2.Search(-1), -1);
+    }
+
+    TEST_F(CDATest, segments) {
+        for (int i = 0; i < 8; ++i) {
+            c1.AddEnd(i);
+        }
+
+        CDA<int>::Span span = c1.Segments();
+        EXPECT_EQ(span.firstLength, 8);
+        EXPECT_EQ(span.secondLength, 0);
+
+        // Wrap the elements around the end of the buffer
+        c1.DelFront();
+        c1.DelFront();
+        c1.DelFront();
+        c1.AddEnd(8);
+        c1.AddEnd(9);
+
+        span = c1.Segments();
+        EXPECT_EQ(span.firstLength + span.secondLength, 7);
+        EXPECT_EQ(span.secondLength, 2);
+
+        std::vector<int> elements(span.first, span.first + span.firstLength);
+        elements.insert(elements.end(), span.second, span.second + span.secondLength);
+
+        for (int i = 0; i < 7; ++i) {
+            EXPECT_EQ(elements[i], i + 3);
+        }
+
+        EXPECT_EQ(c1.Search(9), 6);
+    }
+
+    TEST_F(CDATest, reallocations) {
+        for (int i = 0; i < 1024; ++i) {
+            c1.AddEnd(i);
+        }
+
+        // 1 -> 2 -> 4 -> ... -> 1024
+        EXPECT_EQ(c1.Reallocations(), 10);
+
+        while (c1.Length() > 0) {
+            c1.DelEnd();
+        }
+
+        // 1024 -> 512 -> ... -> 4
+        EXPECT_EQ(c1.Reallocations(), 18);
+        EXPECT_EQ(c1.EmptySlots(), 4);
+    }
+
+    TEST_F(CDATest, shrinkToMinimum) {
+        // An array emptied before it reaches the minimum is resized up to it
+        c1.AddEnd(1);
+        EXPECT_EQ(c1.EmptySlots(), 0);
+
+        c1.DelEnd();
+        EXPECT_EQ(c1.EmptySlots(), 4);
+
+        CDA<int> c2;
+        c2.AddEnd(1);
+        c2.AddFront(0);
+        c2.DelFront();
+        EXPECT_EQ(c2.EmptySlots(), 1);
+
+        c2.DelFront();
+        EXPECT_EQ(c2.EmptySlots(), 4);
+        c2.AddFront(2);
+        EXPECT_EQ(c2[0], 2);
+    }
+
+    TEST_F(CDATest, growthPolicy) {
+        GrowthPolicy policy;
+        policy.growthFactor = 1.5;
+        policy.shrinkThreshold = 0.5;
+        policy.minimumCapacity = 16;
+        c1.SetGrowthPolicy(policy);
+
+        EXPECT_EQ(c1.GetGrowthPolicy().growthFactor, 1.5);
+
+        for (int i = 0; i < 1000; ++i) {
+            c1.AddEnd(i);
+        }
+
+        // Each growth is by half, so the array ends up less than half empty
+        EXPECT_LT(c1.EmptySlots(), 500);
+
+        while (c1.Length() > 0) {
+            c1.DelFront();
+        }
+
+        EXPECT_EQ(c1.EmptySlots(), 16);
+
+        for (int i = 0; i < 16; ++i) {
+            c1.AddEnd(i);
+        }
+
+        // Hovering around a capacity boundary resizes only once
+        long long before = c1.Reallocations();
+
+        for (int i = 0; i < 1000; ++i) {
+            c1.AddEnd(i);
+            c1.DelEnd();
+        }
+
+        EXPECT_EQ(c1.Reallocations(), before + 1);
+    }
+
+    TEST_F(CDATest, neverShrink) {
+        GrowthPolicy policy;
+        policy.neverShrink = true;
+        c1.SetGrowthPolicy(policy);
+
+        for (int i = 0; i < 100; ++i) {
+            c1.AddEnd(i);
+        }
+
+        long long before = c1.Reallocations();
+
+        while (c1.Length() > 0) {
+            c1.DelEnd();
+        }
+
+        EXPECT_EQ(c1.Reallocations(), before);
+        EXPECT_EQ(c1.EmptySlots(), 128);
+
+        c1.ShrinkToFit();
+        EXPECT_EQ(c1.EmptySlots(), 1);
+    }
+
+    TEST_F(CDATest, invalidGrowthPolicy) {
+        GrowthPolicy policy;
+
+        policy.growthFactor = 1.0;
+        EXPECT_THROW(c1.SetGrowthPolicy(policy), std::string);
+
+        policy.growthFactor = 2.0;
+        policy.shrinkThreshold = 0.5;
+        EXPECT_THROW(c1.SetGrowthPolicy(policy), std::string);
+
+        policy.shrinkThreshold = 0.25;
+        policy.minimumCapacity = 0;
+        EXPECT_THROW(c1.SetGrowthPolicy(policy), std::string);
+    }
+
+    // The parallel and single-threaded sorts agree with std::sort
+    TEST_F(CDATest, mergeSortThreads) {
+        std::vector<int> expected;
+        srand(3);
+
+        for (int i = 0; i < 100000; ++i) {
+            c1.AddEnd(rand() % 1000);
+            expected.push_back(c1[i]);
+        }
+
+        CDA<int> c2(c1);
+        CDA<int> c3(c1);
+        CDA<int> c4(c1);
+        std::sort(expected.begin(), expected.end(), std::greater<int>());
+
+        c1.MergeSort();
+        c2.MergeSort(4);
+        c3.MergeSort(7);
+        c4.MergeSort(0);
+
+        EXPECT_EQ(c1.Ordered(), -1);
+        EXPECT_EQ(c2.Ordered(), -1);
+
+        for (int i = 0; i < 100000; ++i) {
+            EXPECT_EQ(c1[i], expected[i]);
+            EXPECT_EQ(c2[i], expected[i]);
+            EXPECT_EQ(c3[i], expected[i]);
+            EXPECT_EQ(c4[i], expected[i]);
+        }
+    }
+
+    // Equal keys come out in the reverse of their original order, even
+    // when the elements start out wrapped around the end of the buffer
+    TEST_F(CDATest, mergeSortReversesEqualElements) {
+        for (int threads = 1; threads <= 4; threads *= 2) {
+            CDA<Element<int, int>> c2;
+
+            for (int i = 0; i < 50000; ++i) {
+                c2.AddEnd(Element<int, int>{i % 7, i});
+            }
+
+            for (int i = 0; i < 20000; ++i) {
+                c2.DelFront();
+                c2.AddEnd(Element<int, int>{i % 7, 50000 + i});
+            }
+
+            c2.MergeSort(threads);
+
+            for (int i = 1; i < c2.Length(); ++i) {
+                ASSERT_GE(c2[i - 1].key, c2[i].key);
+
+                if (c2[i - 1].key == c2[i].key) {
+                    ASSERT_GT(c2[i - 1].value, c2[i].value);
+                }
+            }
+        }
+    }
+
+    TEST_F(CDATest, mergeSortMovesElements) {
+        CDA<CopyCounter> c2;
+
+        for (int i = 0; i < 50000; ++i) {
+            c2.AddEnd(CopyCounter((i * 7919) % 50000));
+        }
+
+        CopyCounter::copies = 0;
+        c2.MergeSort(4);
+
+        EXPECT_EQ(CopyCounter::copies, 0);
+
+        for (int i = 0; i < 50000; ++i) {
+            EXPECT_EQ(c2[i].id, 49999 - i);
+        }
+    }
+
+    // Checks RadixSort against std::sort in both directions with every digit width
+    template <typename elmtype>
+    void checkRadixSort(const std::vector<elmtype> & values, int threads) {
+        for (int digitBits : {0, 8, 11, 16}) {
+            for (bool increasing : {false, true}) {
+                CDA<elmtype> c;
+
+                // Start the elements partway through the buffer so they wrap
+                for (int i = 0; i < 10; ++i) {
+                    c.AddEnd(values[0]);
+                }
+
+                for (elmtype v : values) {
+                    c.AddEnd(v);
+                }
+
+                for (int i = 0; i < 10; ++i) {
+                    c.DelFront();
+                }
+
+                std::vector<elmtype> expected(values);
+                std::sort(expected.begin(), expected.end());
+
+                if (!increasing) {
+                    std::reverse(expected.begin(), expected.end());
+                }
+
+                c.RadixSort(increasing, threads, digitBits);
+                EXPECT_EQ(c.Ordered(), increasing ? 1 : -1);
+
+                for (int i = 0; i < c.Length(); ++i) {
+                    ASSERT_EQ(c[i], expected[i]);
+                }
+            }
+        }
+    }
+
+    TEST_F(CDATest, radixSortIntegers) {
+        std::vector<int> ints;
+        std::vector<unsigned long long> unsignedLongs;
+        std::vector<signed char> chars;
+        srand(5);
+
+        for (int i = 0; i < 3000; ++i) {
+            ints.push_back(rand() - RAND_MAX / 2);
+            unsignedLongs.push_back(static_cast<unsigned long long>(rand()) << (i % 40));
+            chars.push_back(static_cast<signed char>(rand()));
+        }
+
+        ints.push_back(std::numeric_limits<int>::min());
+        ints.push_back(std::numeric_limits<int>::max());
+
+        checkRadixSort(ints, 1);
+        checkRadixSort(unsignedLongs, 1);
+        checkRadixSort(chars, 1);
+    }
+
+    TEST_F(CDATest, radixSortFloatingPoint) {
+        std::vector<double> doubles = {0.0, -1.5, 1.5, -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(), -1e300, 1e-300};
+        std::vector<float> floats = {0.0f, -2.5f, 2.5f, std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest()};
+        srand(6);
+
+        for (int i = 0; i < 3000; ++i) {
+            doubles.push_back((rand() - RAND_MAX / 2) / 1000.0);
+            floats.push_back((rand() - RAND_MAX / 2) / 7.0f);
+        }
+
+        checkRadixSort(doubles, 1);
+        checkRadixSort(floats, 1);
+    }
+
+    // Big enough for each pass to be split across threads
+    TEST_F(CDATest, radixSortThreads) {
+        std::vector<long long> values;
+        srand(7);
+
+        for (int i = 0; i < 100000; ++i) {
+            values.push_back((static_cast<long long>(rand()) << 20) - (static_cast<long long>(rand()) << 30));
+        }
+
+        checkRadixSort(values, 4);
+    }
+
+    TEST_F(CDATest, radixSortInvalidDigits) {
+        c1.AddEnd(1);
+        EXPECT_THROW(c1.RadixSort(true, 1, 17), std::string);
+        EXPECT_THROW(c1.RadixSort(true, 1, -1), std::string);
+    }
+
+    TEST_F(CDATest, countingSort) {
+        std::vector<int> values;
+        srand(8);
+
+        for (int i = 0; i < 5000; ++i) {
+            values.push_back(rand() % 2001 - 1000);
+        }
+
+        for (bool increasing : {false, true}) {
+            for (bool inPlace : {false, true}) {
+                CDA<int> c2;
+
+                // Start the elements partway through the buffer so they wrap
+                for (int i = 0; i < 10; ++i) {
+                    c2.AddEnd(0);
+                }
+
+                for (int v : values) {
+                    c2.AddEnd(v);
+                }
+
+                for (int i = 0; i < 10; ++i) {
+                    c2.DelFront();
+                }
+
+                if (inPlace) {
+                    c2.CountingSortInPlace(1000, -1000, increasing);
+                }
+
+                else {
+                    c2.CountingSort(1000, -1000, increasing);
+                }
+
+                std::vector<int> expected(values);
+                std::sort(expected.begin(), expected.end());
+
+                if (!increasing) {
+                    std::reverse(expected.begin(), expected.end());
+                }
+
+                EXPECT_EQ(c2.Ordered(), increasing ? 1 : -1);
+
+                for (int i = 0; i < c2.Length(); ++i) {
+                    ASSERT_EQ(c2[i], expected[i]);
+                }
+            }
+        }
+    }
+
+    // The counts live on the heap, so a wide range of keys is fine
+    TEST_F(CDATest, countingSortWideRange) {
+        for (int i = 0; i < 1000; ++i) {
+            c1.AddEnd((i * 7919) % 1000 * 20000);
+        }
+
+        c1.CountingSortInPlace(20000000);
+
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_EQ(c1[i], (999 - i) * 20000);
+        }
+
+        c1.CountingSort(20000000, 0, true);
+
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_EQ(c1[i], i * 20000);
+        }
+    }
+
+    // Elements outside the range are caught before anything moves
+    TEST_F(CDATest, countingSortOutOfRange) {
+        c1.AddEnd(3);
+        c1.AddEnd(-1);
+        c1.AddEnd(2);
+
+        EXPECT_THROW(c1.CountingSort(3), std::string);
+        EXPECT_THROW(c1.CountingSortInPlace(2, -1), std::string);
+        EXPECT_THROW(c1.CountingSort(-1, 3), std::string);
+
+        EXPECT_EQ(c1[0], 3);
+        EXPECT_EQ(c1[1], -1);
+        EXPECT_EQ(c1[2], 2);
+    }
+
+    // Checks every rank of an unsorted array against a sorted copy,
+    // and that Select leaves the array partitioned around the rank
+    void checkSelect(const std::vector<int> & values) {
+        std::vector<int> expected(values);
+        std::sort(expected.begin(), expected.end());
+
+        for (int k = 1; k <= static_cast<int>(values.size()); k += 1 + values.size() / 200) {
+            CDA<int> c;
+
+            for (int v : values) {
+                c.AddFront(v);
+            }
+
+            ASSERT_EQ(c.Select(k), expected[k - 1]);
+
+            for (int i = 0; i < c.Length(); ++i) {
+                if (i < k - 1) {
+                    ASSERT_LE(c[i], expected[k - 1]);
+                }
+
+                else {
+                    ASSERT_GE(c[i], expected[k - 1]);
+                }
+            }
+        }
+    }
+
+    TEST_F(CDATest, select) {
+        std::vector<int> random;
+        std::vector<int> increasing;
+        std::vector<int> decreasing;
+        std::vector<int> equal(3000, 7);
+        std::vector<int> organPipe;
+        std::vector<int> fewValues;
+        srand(9);
+
+        for (int i = 0; i < 3000; ++i) {
+            random.push_back(rand() % 100000);
+            increasing.push_back(i);
+            decreasing.push_back(3000 - i);
+            organPipe.push_back(i < 1500 ? i : 3000 - i);
+            fewValues.push_back(rand() % 3);
+        }
+
+        checkSelect(random);
+        checkSelect(increasing);
+        checkSelect(decreasing);
+        checkSelect(equal);
+        checkSelect(organPipe);
+        checkSelect(fewValues);
+        checkSelect(std::vector<int>(1, 42));
+    }
+
+    // Sorted arrays are read directly, and out of range ranks are rejected
+    TEST_F(CDATest, selectSorted) {
+        for (int i = 0; i < 100; ++i) {
+            c1.AddEnd((i * 37) % 100);
+        }
+
+        c1.MergeSort();
+        EXPECT_EQ(c1.Select(1), 0);
+        EXPECT_EQ(c1.Select(100), 99);
+
+        c1.CountingSort(99, 0, true);
+        EXPECT_EQ(c1.Select(10), 9);
+
+        EXPECT_EQ(c1.Select(0), c1.Select(101));
+    }
+
+    TEST_F(CDATest, selectMany) {
+        std::vector<int> values;
+        srand(10);
+
+        for (int i = 0; i < 10000; ++i) {
+            values.push_back(rand() % 5000);
+            c1.AddEnd(values[i]);
+        }
+
+        std::sort(values.begin(), values.end());
+
+        int ks[] = {9900, 5000, 1, 9000, 5000, 10000, 2};
+        int results[7];
+        c1.SelectMany(ks, 7, results);
+
+        for (int i = 0; i < 7; ++i) {
+            EXPECT_EQ(results[i], values[ks[i] - 1]);
+        }
+
+        c1.MergeSort();
+        int sortedResults[7];
+        c1.SelectMany(ks, 7, sortedResults);
+
+        for (int i = 0; i < 7; ++i) {
+            EXPECT_EQ(sortedResults[i], results[i]);
+        }
+
+        int badKs[] = {1, 10001};
+        EXPECT_THROW(c1.SelectMany(badKs, 2, results), std::string);
+    }
+
+    // Big enough for Select to partition in parallel before finishing alone
+    TEST_F(CDATest, parallelSelect) {
+        std::vector<int> values;
+        srand(11);
+
+        for (int i = 0; i < 100000; ++i) {
+            values.push_back(rand() % 1000);
+        }
+
+        std::vector<int> expected(values);
+        std::sort(expected.begin(), expected.end());
+
+        for (int k : {1, 777, 50000, 99999, 100000}) {
+            CDA<std::string> c;
+
+            for (int v : values) {
+                c.AddEnd(std::to_string(v + 1000));
+            }
+
+            EXPECT_EQ(c.Select(k, 4), std::to_string(expected[k - 1] + 1000));
+
+            for (int i = 0; i < c.Length(); ++i) {
+                if (i < k - 1) {
+                    ASSERT_LE(c[i], std::to_string(expected[k - 1] + 1000));
+                }
+
+                else {
+                    ASSERT_GE(c[i], std::to_string(expected[k - 1] + 1000));
+                }
+            }
+        }
+    }
+
+    // The parallel search finds the first match, wherever the threads start
+    TEST_F(CDATest, parallelSearch) {
+        for (int i = 0; i < 100000; ++i) {
+            c1.AddFront(i % 50000);
+        }
+
+        EXPECT_EQ(c1.Search(49999, 4), 0);
+        EXPECT_EQ(c1.Search(0, 4), 49999);
+        EXPECT_EQ(c1.Search(12345, 3), 37654);
+        EXPECT_EQ(c1.Search(-1, 4), -1);
+        EXPECT_EQ(c1.Search(12345, 0), c1.Search(12345));
+    }
 }
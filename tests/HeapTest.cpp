@@ -3,8 +3,28 @@
 #include <string>
 #include <sstream>
 #include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
 
 namespace {
+    // Counts copies, so tests can check that sifting only moves keys
+    struct CopyCounter {
+        static int copies;
+        int id;
+
+        CopyCounter() : id(0) {}
+        CopyCounter(int i) : id(i) {}
+        CopyCounter(const CopyCounter & other) : id(other.id) { ++copies; }
+        CopyCounter(CopyCounter && other) noexcept : id(other.id) {}
+        CopyCounter & operator=(const CopyCounter & other) { id = other.id; ++copies; return *this; }
+        CopyCounter & operator=(CopyCounter && other) noexcept { id = other.id; return *this; }
+        bool operator<(const CopyCounter & other) const { return id < other.id; }
+        bool operator>(const CopyCounter & other) const { return id > other.id; }
+    };
+
+    int CopyCounter::copies = 0;
+
     class HeapTest : public ::testing::Test {
         protected:
             int k1[10] = {5, 3, 2, 6, 8, 9, 0, 1, 4, 7};
@@ -106,4 +126,101 @@ namespace {
 
         // Should print the same thing twice
     }
+
+    // Inserts and extracts in a random mix, checking every minimum against a sorted copy
+    template <int arity>
+    void checkArity(int inputSize) {
+        std::vector<int> values;
+        srand(arity);
+
+        for (int i = 0; i < inputSize; ++i) {
+            values.push_back(rand() % 1000);
+        }
+
+        Heap<int, arity> h1(values.data(), inputSize / 2);
+        std::vector<int> live(values.begin(), values.begin() + inputSize / 2);
+
+        for (int i = inputSize / 2; i < inputSize; ++i) {
+            h1.insert(values[i]);
+            live.push_back(values[i]);
+
+            if (i % 3 == 0) {
+                std::vector<int>::iterator min = std::min_element(live.begin(), live.end());
+                ASSERT_EQ(h1.extractMin(), *min);
+                live.erase(min);
+            }
+        }
+
+        std::sort(live.begin(), live.end());
+
+        for (int v : live) {
+            ASSERT_EQ(h1.extractMin(), v);
+        }
+    }
+
+    TEST_F(HeapTest, arity) {
+        checkArity<2>(3000);
+        checkArity<3>(3000);
+        checkArity<4>(3000);
+        checkArity<8>(3000);
+        checkArity<16>(3000);
+    }
+
+    // Siblings start at a multiple of the arity, so the slots before the root stay unused
+    TEST_F(HeapTest, arityLayout) {
+        Heap<int, 4> h1(k1, size1);
+        EXPECT_EQ(h1.peekKey(), 0);
+
+        std::istringstream keys(h1.stringKey());
+        std::vector<int> levels;
+        int k;
+
+        while (keys >> k) {
+            levels.push_back(k);
+        }
+
+        // One root and then its four children, each smaller than its own children
+        ASSERT_EQ(levels.size(), 10u);
+
+        for (int i = 1; i < 10; ++i) {
+            EXPECT_LE(levels[(i - 1) / 4], levels[i]);
+        }
+
+        Heap<std::string, 8> h2;
+        h2.insert("b");
+        h2.insert("a");
+        h2.insert("c");
+        EXPECT_EQ(h2.stringKey(), "a b c");
+    }
+
+    TEST_F(HeapTest, siftMovesKeys) {
+        Heap<CopyCounter, 4> h1;
+        CopyCounter::copies = 0;
+
+        for (int i = 0; i < 1000; ++i) {
+            h1.insert(CopyCounter((i * 7919) % 1000));
+        }
+
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_EQ(h1.extractMin().id, i);
+        }
+
+        EXPECT_EQ(CopyCounter::copies, 0);
+    }
+
+    TEST_F(HeapTest, strings) {
+        Heap<std::string> h1;
+
+        for (int i = 0; i < 500; ++i) {
+            h1.insert(std::string(30, 'a' + (i * 7) % 26) + std::to_string(i));
+        }
+
+        std::string previous = h1.extractMin();
+
+        for (int i = 1; i < 500; ++i) {
+            std::string next = h1.extractMin();
+            EXPECT_LE(previous, next);
+            previous = next;
+        }
+    }
 }
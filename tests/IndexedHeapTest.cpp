@@ -0,0 +1,307 @@
+#include "IndexedHeap.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace {
+    TEST(IndexedHeapTest, insertAndExtract) {
+        int k[10] = {5, 3, 2, 6, 8, 9, 0, 1, 4, 7};
+        IndexedHeap<int> h;
+
+        for (int i = 0; i < 10; ++i) {
+            h.insert(k[i]);
+        }
+
+        EXPECT_EQ(h.size(), 10);
+        EXPECT_EQ(h.peekKey(), 0);
+
+        for (int i = 0; i < 10; ++i) {
+            EXPECT_EQ(h.extractMin(), i);
+        }
+
+        EXPECT_TRUE(h.empty());
+    }
+
+    TEST(IndexedHeapTest, handles) {
+        IndexedHeap<std::string> h;
+        int b = h.insert("b");
+        int a = h.insert("a");
+        int c = h.insert("c");
+
+        EXPECT_EQ(h.getKey(a), "a");
+        EXPECT_EQ(h.getKey(b), "b");
+        EXPECT_EQ(h.getKey(c), "c");
+        EXPECT_EQ(h.peekHandle(), a);
+
+        EXPECT_EQ(h.extractMin(), "a");
+        EXPECT_FALSE(h.contains(a));
+        EXPECT_TRUE(h.contains(b));
+        EXPECT_FALSE(h.contains(-1));
+        EXPECT_FALSE(h.contains(3));
+
+        // The extracted entry's handle is reused
+        int d = h.insert("d");
+        EXPECT_EQ(d, a);
+        EXPECT_EQ(h.getKey(d), "d");
+        EXPECT_EQ(h.getKey(b), "b");
+    }
+
+    TEST(IndexedHeapTest, decreaseAndIncreaseKey) {
+        IndexedHeap<int, 4> h;
+        int handles[100];
+
+        for (int i = 0; i < 100; ++i) {
+            handles[i] = h.insert(i * 10);
+        }
+
+        h.decreaseKey(handles[50], -1);
+        EXPECT_EQ(h.peekHandle(), handles[50]);
+        EXPECT_EQ(h.peekKey(), -1);
+
+        h.increaseKey(handles[50], 1000);
+        h.increaseKey(handles[0], 995);
+        EXPECT_EQ(h.peekKey(), 10);
+
+        // Equal keys are allowed both ways
+        h.decreaseKey(handles[1], 10);
+        h.increaseKey(handles[1], 10);
+
+        for (int i = 1; i < 100; ++i) {
+            if (i != 50) {
+                EXPECT_EQ(h.extractMin(), i * 10);
+            }
+        }
+
+        EXPECT_EQ(h.extractMin(), 995);
+        EXPECT_EQ(h.extractMin(), 1000);
+    }
+
+    TEST(IndexedHeapTest, erase) {
+        IndexedHeap<int, 3> h;
+        int handles[20];
+
+        for (int i = 0; i < 20; ++i) {
+            handles[i] = h.insert(19 - i);
+        }
+
+        // Erase the minimum, a leaf and the last slot
+        h.erase(handles[19]);
+        h.erase(handles[5]);
+        h.erase(handles[0]);
+        EXPECT_EQ(h.size(), 17);
+        EXPECT_FALSE(h.contains(handles[5]));
+
+        for (int i = 1; i < 19; ++i) {
+            if (i != 14) {
+                EXPECT_EQ(h.extractMin(), i);
+            }
+        }
+
+        EXPECT_TRUE(h.empty());
+    }
+
+    TEST(IndexedHeapTest, releasesErasedKeys) {
+        // Each pointer's use count tells whether the heap still holds a copy
+        IndexedHeap<std::shared_ptr<int>> h;
+        std::shared_ptr<int> keys[3];
+        int handles[3];
+
+        for (int i = 0; i < 3; ++i) {
+            keys[i] = std::make_shared<int>(i);
+            handles[i] = h.insert(keys[i]);
+            EXPECT_EQ(keys[i].use_count(), 2);
+        }
+
+        h.erase(handles[1]);
+        EXPECT_EQ(keys[1].use_count(), 1);
+
+        h.extractMin();
+        h.extractMin();
+        EXPECT_EQ(keys[0].use_count(), 1);
+        EXPECT_EQ(keys[2].use_count(), 1);
+    }
+
+    TEST(IndexedHeapTest, errors) {
+        IndexedHeap<int> h;
+
+        EXPECT_THROW(h.peekKey(), std::string);
+        EXPECT_THROW(h.extractMin(), std::string);
+
+        int a = h.insert(5);
+
+        try {
+            h.decreaseKey(a, 6);
+            FAIL();
+        }
+
+        catch (std::string e) {
+            EXPECT_EQ(e, "IHD1");
+        }
+
+        try {
+            h.increaseKey(a, 4);
+            FAIL();
+        }
+
+        catch (std::string e) {
+            EXPECT_EQ(e, "IHI1");
+        }
+
+        h.erase(a);
+
+        try {
+            h.erase(a);
+            FAIL();
+        }
+
+        catch (std::string e) {
+            EXPECT_EQ(e, "IHH1");
+        }
+
+        try {
+            h.peekHandle();
+            FAIL();
+        }
+
+        catch (std::string e) {
+            EXPECT_EQ(e, "IHE1");
+        }
+
+        EXPECT_THROW(h.getKey(a), std::string);
+        EXPECT_THROW(h.decreaseKey(7, 1), std::string);
+    }
+
+    // Runs random operations against a multimap that holds the same entries
+    template <int arity>
+    void checkRandom() {
+        IndexedHeap<int, arity> h;
+        std::map<int, int> keyOf;
+        std::multimap<int, int> byKey;
+        std::srand(arity);
+
+        auto remove = [&](int handle) {
+            auto range = byKey.equal_range(keyOf[handle]);
+
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == handle) {
+                    byKey.erase(it);
+                    break;
+                }
+            }
+
+            keyOf.erase(handle);
+        };
+
+        for (int step = 0; step < 20000; ++step) {
+            int op = std::rand() % 6;
+
+            if (keyOf.empty() || op <= 1) {
+                int k = std::rand() % 1000;
+                int handle = h.insert(k);
+                ASSERT_EQ(keyOf.count(handle), 0u);
+                keyOf[handle] = k;
+                byKey.emplace(k, handle);
+            }
+
+            else if (op == 2) {
+                // Equal keys may come out in any order, so follow the handle
+                int handle = h.peekHandle();
+                ASSERT_EQ(h.extractMin(), byKey.begin()->first);
+                remove(handle);
+            }
+
+            else {
+                auto it = keyOf.begin();
+                std::advance(it, std::rand() % keyOf.size());
+                int handle = it->first;
+                int k = it->second;
+                ASSERT_EQ(h.getKey(handle), k);
+
+                if (op == 3) {
+                    remove(handle);
+                    h.decreaseKey(handle, k - std::rand() % 100);
+                }
+
+                else if (op == 4) {
+                    remove(handle);
+                    h.increaseKey(handle, k + std::rand() % 100);
+                }
+
+                else {
+                    remove(handle);
+                    h.erase(handle);
+                    continue;
+                }
+
+                keyOf[handle] = h.getKey(handle);
+                byKey.emplace(keyOf[handle], handle);
+            }
+
+            ASSERT_EQ(h.size(), (int) keyOf.size());
+
+            if (!h.empty()) {
+                ASSERT_EQ(h.peekKey(), byKey.begin()->first);
+            }
+        }
+
+        while (!h.empty()) {
+            ASSERT_EQ(h.extractMin(), byKey.begin()->first);
+            byKey.erase(byKey.begin());
+        }
+    }
+
+    TEST(IndexedHeapTest, random) {
+        checkRandom<2>();
+        checkRandom<3>();
+        checkRandom<4>();
+        checkRandom<8>();
+    }
+
+    TEST(IndexedHeapTest, dijkstra) {
+        // Shortest distances from node 0, lowering each node's entry in place
+        const int n = 6;
+        int weight[n][n] = {
+            {0, 7, 9, 0, 0, 14},
+            {7, 0, 10, 15, 0, 0},
+            {9, 10, 0, 11, 0, 2},
+            {0, 15, 11, 0, 6, 0},
+            {0, 0, 0, 6, 0, 9},
+            {14, 0, 2, 0, 9, 0}
+        };
+        const int infinity = std::numeric_limits<int>::max();
+        int distance[n];
+        int handle[n];
+        IndexedHeap<int> h;
+
+        for (int i = 0; i < n; ++i) {
+            distance[i] = (i == 0) ? 0 : infinity;
+            handle[i] = h.insert(distance[i]);
+        }
+
+        while (!h.empty()) {
+            int u = std::find(handle, handle + n, h.peekHandle()) - handle;
+            h.extractMin();
+            handle[u] = -1;
+
+            for (int v = 0; v < n; ++v) {
+                if (weight[u][v] > 0 && handle[v] != -1 && distance[u] + weight[u][v] < distance[v]) {
+                    distance[v] = distance[u] + weight[u][v];
+                    h.decreaseKey(handle[v], distance[v]);
+                }
+            }
+
+            EXPECT_LE(h.size(), n);
+        }
+
+        int expected[n] = {0, 7, 9, 20, 20, 11};
+
+        for (int i = 0; i < n; ++i) {
+            EXPECT_EQ(distance[i], expected[i]);
+        }
+    }
+}
@@ -0,0 +1,208 @@
+#include "MPMCQueue.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    TEST(MPMCQueueTest, capacity) {
+        MPMCQueue<int> q1(1);
+        MPMCQueue<int> q2(100);
+
+        EXPECT_EQ(q1.Capacity(), 1);
+        EXPECT_EQ(q2.Capacity(), 128);
+
+        EXPECT_THROW(MPMCQueue<int> q3(0), std::string);
+    }
+
+    TEST(MPMCQueueTest, pushAndPop) {
+        MPMCQueue<int> q(4);
+        int v;
+
+        EXPECT_FALSE(q.TryPop(v));
+
+        // Go around the ring several times
+        for (int round = 0; round < 10; ++round) {
+            for (int i = 0; i < 4; ++i) {
+                EXPECT_TRUE(q.TryPush(round * 4 + i));
+            }
+
+            EXPECT_FALSE(q.TryPush(-1));
+            EXPECT_EQ(q.Length(), 4);
+
+            for (int i = 0; i < 4; ++i) {
+                EXPECT_TRUE(q.TryPop(v));
+                EXPECT_EQ(v, round * 4 + i);
+            }
+
+            EXPECT_FALSE(q.TryPop(v));
+            EXPECT_EQ(q.Length(), 0);
+        }
+    }
+
+    TEST(MPMCQueueTest, batch) {
+        MPMCQueue<std::string> q(8);
+        std::string items[12];
+
+        for (int i = 0; i < 12; ++i) {
+            items[i] = std::to_string(i);
+        }
+
+        EXPECT_EQ(q.PushBatch(items, 5), 5);
+        EXPECT_EQ(q.PushBatch(items + 5, 7), 3);
+        EXPECT_EQ(q.PushBatch(items, 1), 0);
+
+        std::string popped[12];
+        EXPECT_EQ(q.PopBatch(popped, 6), 6);
+        EXPECT_EQ(q.PushBatch(items + 8, 4), 4);
+        EXPECT_EQ(q.PopBatch(popped + 6, 12), 6);
+        EXPECT_EQ(q.PopBatch(popped, 1), 0);
+
+        for (int i = 0; i < 12; ++i) {
+            EXPECT_EQ(popped[i], items[i]);
+        }
+    }
+
+    TEST(MPMCQueueTest, emptyBatch) {
+        MPMCQueue<int> q(8);
+        int items[3] = {1, 2, 3};
+
+        EXPECT_EQ(q.PushBatch(items, 3), 3);
+        EXPECT_EQ(q.PushBatch(items, 0), 0);
+        EXPECT_EQ(q.PushBatch(items, -1), 0);
+        EXPECT_EQ(q.PopBatch(items, 0), 0);
+        EXPECT_EQ(q.PopBatch(items, -1), 0);
+        EXPECT_EQ(q.Length(), 3);
+
+        int popped[3];
+        EXPECT_EQ(q.PopBatch(popped, 3), 3);
+        EXPECT_EQ(popped[2], 3);
+    }
+
+    // Elements left in the queue are destroyed with it
+    TEST(MPMCQueueTest, destructor) {
+        MPMCQueue<std::string> q(4);
+        q.TryEmplace(40, 'a');
+        q.Push(std::string(50, 'b'));
+
+        std::string v;
+        q.Pop(v);
+        EXPECT_EQ(v, std::string(40, 'a'));
+        q.TryPush(std::string(60, 'c'));
+    }
+
+    // Every value pushed by any producer comes out exactly once, and
+    // each producer's values come out in the order it pushed them
+    TEST(MPMCQueueTest, manyProducersManyConsumers) {
+        const int numProducers = 4;
+        const int numConsumers = 4;
+        const int perProducer = 20000;
+        MPMCQueue<int> q(64);
+
+        std::vector<std::thread> threads;
+        std::vector<std::vector<int>> received(numConsumers);
+
+        for (int p = 0; p < numProducers; ++p) {
+            threads.emplace_back([&q, p]() {
+                for (int i = 0; i < perProducer; ++i) {
+                    q.Push(p * perProducer + i);
+                }
+            });
+        }
+
+        for (int c = 0; c < numConsumers; ++c) {
+            threads.emplace_back([&q, &received, c]() {
+                for (int i = 0; i < numProducers * perProducer / numConsumers; ++i) {
+                    int v;
+                    q.Pop(v);
+                    received[c].push_back(v);
+                }
+            });
+        }
+
+        for (std::thread & t : threads) {
+            t.join();
+        }
+
+        std::vector<int> seen(numProducers * perProducer, 0);
+
+        for (const std::vector<int> & values : received) {
+            std::vector<int> last(numProducers, -1);
+
+            for (int v : values) {
+                ++seen[v];
+                EXPECT_GT(v, last[v / perProducer]);
+                last[v / perProducer] = v;
+            }
+        }
+
+        for (int count : seen) {
+            EXPECT_EQ(count, 1);
+        }
+    }
+
+    TEST(MPMCQueueTest, concurrentBatches) {
+        const int numThreads = 3;
+        const int perProducer = 30000;
+        const int batchSize = 16;
+        MPMCQueue<int> q(128);
+
+        std::vector<std::thread> threads;
+        std::vector<long long> sums(numThreads, 0);
+
+        for (int p = 0; p < numThreads; ++p) {
+            threads.emplace_back([&q, p]() {
+                int items[batchSize];
+
+                for (int next = 0; next < perProducer; next += batchSize) {
+                    for (int i = 0; i < batchSize; ++i) {
+                        items[i] = p * perProducer + next + i;
+                    }
+
+                    for (int pushed = 0; pushed < batchSize;) {
+                        int count = q.PushBatch(items + pushed, batchSize - pushed);
+                        pushed += count;
+
+                        if (count == 0) {
+                            std::this_thread::yield();
+                        }
+                    }
+                }
+            });
+        }
+
+        for (int c = 0; c < numThreads; ++c) {
+            threads.emplace_back([&q, &sums, c]() {
+                int items[batchSize];
+
+                for (int received = 0; received < perProducer;) {
+                    int wanted = (perProducer - received < batchSize) ? perProducer - received : batchSize;
+                    int count = q.PopBatch(items, wanted);
+
+                    for (int i = 0; i < count; ++i) {
+                        sums[c] += items[i];
+                    }
+
+                    received += count;
+
+                    if (count == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        for (std::thread & t : threads) {
+            t.join();
+        }
+
+        long long total = 0;
+        for (long long sum : sums) {
+            total += sum;
+        }
+
+        long long n = numThreads * perProducer;
+        EXPECT_EQ(total, n * (n - 1) / 2);
+        EXPECT_EQ(q.Length(), 0);
+    }
+}
@@ -0,0 +1,158 @@
+#include "NodePool.h"
+#include "Node.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+    TEST(NodePoolTest, defaultConstructor) {
+        NodePool<Node<int, int>> p;
+
+        EXPECT_EQ(p.getLiveNodes(), 0);
+        EXPECT_EQ(p.getSlabCount(), 0);
+        EXPECT_EQ(p.getBytesReserved(), 0);
+    }
+
+    TEST(NodePoolTest, create) {
+        NodePool<Node<std::string, int>> p;
+
+        Node<std::string, int>* n1 = p.create();
+        Node<std::string, int>* n2 = p.create((std::string) "hello", 5);
+
+        EXPECT_EQ(p.getLiveNodes(), 2);
+        EXPECT_EQ(p.getSlabCount(), 1);
+        EXPECT_GT(p.getBytesReserved(), 0);
+
+        EXPECT_EQ(n1->getNumElements(), 0);
+        EXPECT_EQ(n2->getElement(0).key, "hello");
+        EXPECT_EQ(n2->getElement(0).value, 5);
+
+        p.destroy(n1);
+        p.destroy(n2);
+        EXPECT_EQ(p.getLiveNodes(), 0);
+    }
+
+    TEST(NodePoolTest, destroyReusesSlots) {
+        NodePool<Node<int, int>> p;
+
+        Node<int, int>* n1 = p.create(1, 1);
+        p.destroy(n1);
+
+        Node<int, int>* n2 = p.create(2, 2);
+        EXPECT_EQ(n1, n2);
+        EXPECT_EQ(p.getLiveNodes(), 1);
+        EXPECT_EQ(p.getSlabCount(), 1);
+    }
+
+    TEST(NodePoolTest, slabGrowth) {
+        NodePool<Node<int, int>> p;
+        int inputSize = 100000;
+
+        std::vector<Node<int, int>*> nodes;
+        for (int i = 0; i < inputSize; ++i) {
+            nodes.push_back(p.create(i, i));
+        }
+
+        EXPECT_EQ(p.getLiveNodes(), inputSize);
+        EXPECT_LT(p.getSlabCount(), 40);
+        EXPECT_GE(p.getBytesReserved(), (long long) inputSize * (long long) sizeof(Node<int, int>));
+
+        for (int i = 0; i < inputSize; ++i) {
+            EXPECT_EQ(nodes[i]->getElement(0).key, i);
+        }
+
+        p.clear();
+        EXPECT_EQ(p.getLiveNodes(), 0);
+        EXPECT_EQ(p.getSlabCount(), 0);
+        EXPECT_EQ(p.getBytesReserved(), 0);
+    }
+
+    TEST(NodePoolTest, swap) {
+        NodePool<Node<int, int>> p1;
+        NodePool<Node<int, int>> p2;
+
+        p1.create(1, 1);
+        swap(p1, p2);
+
+        EXPECT_EQ(p1.getLiveNodes(), 0);
+        EXPECT_EQ(p2.getLiveNodes(), 1);
+    }
+
+    TEST(NodePoolTest, splice) {
+        NodePool<Node<int, int>> p1;
+        NodePool<Node<int, int>> p2;
+        std::vector<Node<int, int>*> nodes;
+
+        for (int i = 0; i < 100; ++i) {
+            nodes.push_back(p1.create(i, i));
+            nodes.push_back(p2.create(-i, i));
+        }
+
+        p1.destroy(nodes[0]);
+        p2.destroy(nodes[1]);
+        p1.splice(p2);
+
+        EXPECT_EQ(p1.getLiveNodes(), 198);
+        EXPECT_EQ(p2.getLiveNodes(), 0);
+        EXPECT_EQ(p2.getSlabCount(), 0);
+        EXPECT_EQ(p2.getBytesReserved(), 0);
+
+        // Nodes from p2 now belong to p1, and the free slots of both pools
+        // are reused before any new ones
+        p1.destroy(nodes[3]);
+        Node<int, int>* reused[3];
+
+        for (int i = 0; i < 3; ++i) {
+            reused[i] = p1.create(5, 5);
+        }
+
+        EXPECT_EQ(reused[0], nodes[3]);
+        EXPECT_EQ(reused[1], nodes[0]);
+        EXPECT_EQ(reused[2], nodes[1]);
+
+        for (int i = 0; i < 1000; ++i) {
+            p1.create(i, i);
+        }
+
+        for (int i = 4; i < 200; ++i) {
+            EXPECT_EQ(nodes[i]->getElement(0).key, (i % 2 == 0) ? i / 2 : -(i / 2));
+        }
+
+        p2.create(1, 1);
+        EXPECT_EQ(p2.getLiveNodes(), 1);
+        EXPECT_EQ(p1.getLiveNodes(), 1200);
+    }
+
+    TEST(NodePoolTest, spliceKeepsCurrentSlab) {
+        // 20 nodes fill the 16-node slab and 4 slots of the 32-node one
+        NodePool<Node<int, int>> p1;
+        NodePool<Node<int, int>> p2;
+
+        for (int i = 0; i < 20; ++i) {
+            p1.create(i, i);
+            p2.create(i, i);
+        }
+
+        NodePool<Node<int, int>> p3;
+        NodePool<Node<int, int>> p4;
+        p3.create(1, 1);
+        p4.create(1, 1);
+
+        // Whichever side has the roomier slab, its 28 unused slots are used next
+        p1.splice(p3);
+        p4.splice(p2);
+
+        for (NodePool<Node<int, int>>* p : {&p1, &p4}) {
+            EXPECT_EQ(p->getSlabCount(), 3);
+
+            for (int i = 0; i < 28; ++i) {
+                p->create(i, i);
+            }
+
+            EXPECT_EQ(p->getSlabCount(), 3);
+            p->create(0, 0);
+            EXPECT_EQ(p->getSlabCount(), 4);
+            EXPECT_EQ(p->getLiveNodes(), 50);
+        }
+    }
+}
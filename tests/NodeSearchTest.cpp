@@ -0,0 +1,109 @@
+#include "NodeSearch.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace {
+    template <typename keytype>
+    int expectedChildIndex(const keytype* keys, int numElements, const keytype & k) {
+        for (int i = 0; i < numElements; ++i) {
+            if (k < keys[i]) {
+                return i;
+            }
+        }
+
+        return numElements;
+    }
+
+    template <typename keytype>
+    int expectedIndexOf(const keytype* keys, int numElements, const keytype & k) {
+        for (int i = 0; i < numElements; ++i) {
+            if (k == keys[i]) {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    // Fills the live slots with sorted keys and the spare slots with junk,
+    // then checks every query against the plain loop.
+    template <typename keytype, int order, typename generator>
+    void compareWithScalar(generator next) {
+        std::mt19937 rng(1);
+
+        for (int trial = 0; trial < 2000; ++trial) {
+            keytype keys[nodeKeySlots(order)];
+            int numElements = rng() % order;
+
+            for (int i = 0; i < nodeKeySlots(order); ++i) {
+                keys[i] = next(rng);
+            }
+
+            std::sort(keys, keys + numElements);
+
+            for (int q = 0; q < 8; ++q) {
+                keytype k = (q < numElements) ? keys[q] : next(rng);
+
+                EXPECT_EQ(NodeSearch<keytype>::childIndex(keys, numElements, k), expectedChildIndex(keys, numElements, k));
+                EXPECT_EQ(NodeSearch<keytype>::indexOf(keys, numElements, k), expectedIndexOf(keys, numElements, k));
+            }
+        }
+    }
+
+    TEST(NodeSearchTest, int32) {
+        compareWithScalar<int, 4>([](std::mt19937 & rng) { return (int) (rng() % 20) - 10; });
+        compareWithScalar<int, 4>([](std::mt19937 & rng) { return (int) rng(); });
+    }
+
+    TEST(NodeSearchTest, unsigned32) {
+        compareWithScalar<unsigned int, 4>([](std::mt19937 & rng) { return (unsigned int) rng(); });
+        compareWithScalar<unsigned int, 4>([](std::mt19937 & rng) { return (rng() % 2) ? 0x80000000u + rng() % 4 : rng() % 4; });
+    }
+
+    TEST(NodeSearchTest, float32) {
+        compareWithScalar<float, 4>([](std::mt19937 & rng) { return (float) ((int) (rng() % 20) - 10) / 4; });
+    }
+
+    TEST(NodeSearchTest, int64) {
+        compareWithScalar<long long, 4>([](std::mt19937 & rng) { return ((long long) rng() << 32) - (long long) rng(); });
+        compareWithScalar<long long, 4>([](std::mt19937 & rng) { return (long long) (rng() % 10) - 5; });
+    }
+
+    TEST(NodeSearchTest, float64) {
+        compareWithScalar<double, 4>([](std::mt19937 & rng) { return (double) ((int) (rng() % 20) - 10) / 8; });
+    }
+
+    TEST(NodeSearchTest, string) {
+        compareWithScalar<std::string, 4>([](std::mt19937 & rng) { return std::string(1, 'a' + rng() % 10); });
+    }
+
+    TEST(NodeSearchTest, extremes) {
+        int keys[nodeKeySlots(4)] = {std::numeric_limits<int>::min(), 0, std::numeric_limits<int>::max(), 0};
+
+        EXPECT_EQ(NodeSearch<int>::childIndex(keys, 3, std::numeric_limits<int>::min()), 1);
+        EXPECT_EQ(NodeSearch<int>::childIndex(keys, 3, std::numeric_limits<int>::max()), 3);
+        EXPECT_EQ(NodeSearch<int>::indexOf(keys, 3, std::numeric_limits<int>::max()), 2);
+        EXPECT_EQ(NodeSearch<int>::indexOf(keys, 0, 0), -1);
+    }
+
+    TEST(NodeSearchTest, wideNodes) {
+        compareWithScalar<int, 16>([](std::mt19937 & rng) { return (int) (rng() % 40) - 20; });
+        compareWithScalar<unsigned int, 32>([](std::mt19937 & rng) { return (unsigned int) rng(); });
+        compareWithScalar<float, 64>([](std::mt19937 & rng) { return (float) ((int) (rng() % 100) - 50) / 4; });
+        compareWithScalar<long long, 16>([](std::mt19937 & rng) { return (long long) (rng() % 40) - 20; });
+        compareWithScalar<double, 32>([](std::mt19937 & rng) { return (double) ((int) (rng() % 100) - 50) / 8; });
+        compareWithScalar<std::string, 64>([](std::mt19937 & rng) { return std::string(1, 'a' + rng() % 26); });
+    }
+
+    TEST(NodeSearchTest, keySlots) {
+        EXPECT_EQ(nodeKeySlots(3), 4);
+        EXPECT_EQ(nodeKeySlots(4), 4);
+        EXPECT_EQ(nodeKeySlots(5), 4);
+        EXPECT_EQ(nodeKeySlots(6), 8);
+        EXPECT_EQ(nodeKeySlots(16), 16);
+        EXPECT_EQ(nodeKeySlots(64), 64);
+    }
+}
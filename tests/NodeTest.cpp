@@ -1,7 +1,9 @@
 #include "Node.h"
+#include "NodePool.h"
 #include "Element.h"
 #include <gtest/gtest.h>
 #include <string>
+#include <cstdint>
 
 
 namespace {
@@ -51,89 +53,6 @@ namespace {
         EXPECT_EQ(n2.getParent(), nullptr);
     }
 
-    TEST(NodeTest, copyConstructor) {
-        char x = 'M';
-        int y = 10;
-
-        char x2[3] = {'A', 'B', 'C'};
-        int y2[3] = {10, 20, 30};
-
-        char x3[3] = {'X', 'Y', 'Z'};
-        int y3[3] = {10, 20, 30};
-
-        Node<char, int> n1;
-        Node<char, int>* n2 = new Node<char, int>;
-        Node<char, int>* n3 = new Node<char, int>;
-
-        n1.insert(x, y);
-
-        for (int i = 0; i < 3; ++i) {
-            n2->insert(x2[i], y2[i]);
-        }
-
-        for (int i = 0; i < 3; ++i) {
-            n3->insert(x3[i], y3[i]);
-        }
-
-        n1.insert(n2);
-        n1.insert(n3);
-        
-        Node<char, int> n4(n1);
-
-        EXPECT_EQ(n1.getParent(), n4.getParent());
-        EXPECT_EQ(n1.getNumChildren(), n4.getNumChildren());
-
-        EXPECT_EQ(n1.getElement(0).key, n4.getElement(0).key);
-        EXPECT_EQ(n1.getChild(0)->getElement(1).key, n4.getChild(0)->getElement(1).key);
-        EXPECT_EQ(n1.getChild(1)->getElement(2).key, n4.getChild(1)->getElement(2).key);
-
-
-        EXPECT_NE(n1.getChild(0), n4.getChild(0));
-        n1.remove(n3);
-        
-        EXPECT_NO_THROW(n4.getChild(1));
-    }
-
-    TEST(NodeTest, copyAssignmentOperator) {
-        char x = 'M';
-        int y = 10;
-
-        char x2[3] = {'A', 'B', 'C'};
-        int y2[3] = {10, 20, 30};
-
-        char x3[3] = {'X', 'Y', 'Z'};
-        int y3[3] = {10, 20, 30};
-
-        Node<char, int> n1;
-        Node<char, int>* n2 = new Node<char, int>;
-        Node<char, int>* n3 = new Node<char, int>;
-
-        n1.insert(x, y);
-
-        for (int i = 0; i < 3; ++i) {
-            n2->insert(x2[i], y2[i]);
-        }
-
-        for (int i = 0; i < 3; ++i) {
-            n3->insert(x3[i], y3[i]);
-        }
-
-        n1.insert(n2);
-        n1.insert(n3);
-
-        Node<char, int> n4 = n1;
-        EXPECT_EQ(n1.getParent(), n4.getParent());
-        EXPECT_EQ(n1.getNumChildren(), n4.getNumChildren());
-        
-        EXPECT_EQ(n1.getElement(0).key, n4.getElement(0).key);
-        EXPECT_EQ(n1.getChild(0)->getElement(1).key, n4.getChild(0)->getElement(1).key);
-        EXPECT_EQ(n1.getChild(1)->getElement(2).key, n4.getChild(1)->getElement(2).key);
-
-        EXPECT_NE(n1.getChild(0), n4.getChild(0));
-        n1.remove(n3);
-        EXPECT_NO_THROW(n4.getChild(1));
-    }
-
     TEST(NodeTest, insertKeyValue) {
         std::string x[3] = {"hello", "apple", "tree"};
         char y[3] = {'$', 'z', '*'};
@@ -226,6 +145,7 @@ namespace {
     }
 
     TEST(NodeTest, insertChild) {
+        NodePool<Node<char, int>> pool;
         char x = 'M';
         int y = 10;
 
@@ -236,11 +156,11 @@ namespace {
         int y3[3] = {10, 20, 30};
 
         Node<char, int> n(x, y);
-        Node<char, int>* n2 = new Node<char, int>;
-        Node<char, int>* n3 = new Node<char, int>;
+        Node<char, int>* n2 = pool.create();
+        Node<char, int>* n3 = pool.create();
         Node<char, int> n4(x, y);
-        Node<char, int>* n5 = new Node<char, int>;
-        Node<char, int>* n6 = new Node<char, int>;
+        Node<char, int>* n5 = pool.create();
+        Node<char, int>* n6 = pool.create();
 
         for (int i = 0; i < 3; ++i) {
             n2->insert(x2[i], y2[i]);
@@ -280,6 +200,7 @@ namespace {
     }
 
     TEST(NodeTest, indexOfChild) {
+        NodePool<Node<char, int>> pool;
         char x = 'M';
         int y = 10;
 
@@ -289,12 +210,12 @@ namespace {
         char x3[3] = {'X', 'Y', 'Z'};
         int y3[3] = {10, 20, 30};
 
-        Node<char, int>* n1 = new Node<char, int>;
-        Node<char, int>* n2 = new Node<char, int>;
-        Node<char, int>* n3 = new Node<char, int>;
-        Node<char, int>* n4 = new Node<char, int>;
-        Node<char, int>* n5 = new Node<char, int>;
-        Node<char, int>* n6 = new Node<char, int>;
+        Node<char, int>* n1 = pool.create();
+        Node<char, int>* n2 = pool.create();
+        Node<char, int>* n3 = pool.create();
+        Node<char, int>* n4 = pool.create();
+        Node<char, int>* n5 = pool.create();
+        Node<char, int>* n6 = pool.create();
 
         n1->insert(x, y);
         n4->insert(x, y);
@@ -331,6 +252,7 @@ namespace {
     }
 
     TEST(NodeTest, removeChild) {
+        NodePool<Node<char, int>> pool;
         char x = 'M';
         int y = 10;
 
@@ -340,12 +262,12 @@ namespace {
         char x3[3] = {'X', 'Y', 'Z'};
         int y3[3] = {10, 20, 30};
 
-        Node<char, int>* n1 = new Node<char, int>;
-        Node<char, int>* n2 = new Node<char, int>;
-        Node<char, int>* n3 = new Node<char, int>;
-        Node<char, int>* n4 = new Node<char, int>;
-        Node<char, int>* n5 = new Node<char, int>;
-        Node<char, int>* n6 = new Node<char, int>;
+        Node<char, int>* n1 = pool.create();
+        Node<char, int>* n2 = pool.create();
+        Node<char, int>* n3 = pool.create();
+        Node<char, int>* n4 = pool.create();
+        Node<char, int>* n5 = pool.create();
+        Node<char, int>* n6 = pool.create();
 
         n1->insert(x, y);
         n4->insert(x, y);
@@ -366,7 +288,7 @@ namespace {
             n6->insert(x3[i], y3[i]);
         }
 
-        EXPECT_THROW(n1->remove(n2), std::string);
+        EXPECT_THROW(n1->release(n2), std::string);
     
         n1->insert(n2);
         n1->insert(n3);
@@ -379,16 +301,17 @@ namespace {
         n4->insert(n6);
         n4->insert(n5);
 
-        EXPECT_THROW(n1->remove(n4), std::string);
+        EXPECT_THROW(n1->release(n4), std::string);
 
-        n1->remove(n2);
+        pool.destroy(n1->release(n2));
 
         EXPECT_EQ(n1->getChild(0), n3);
         EXPECT_EQ(n1->getChild(0)->getElement(0).key, n3->getElement(0).key);
-        EXPECT_THROW(n1->remove(n2), std::string);
+        EXPECT_EQ(pool.getLiveNodes(), 5);
     }
 
     TEST(NodeTest, getChildVariations) {
+        NodePool<Node<char, int>> pool;
         char x = 'M';
         int y = 10;
 
@@ -398,9 +321,9 @@ namespace {
         char x3[3] = {'X', 'Y', 'Z'};
         int y3[3] = {10, 20, 30};
 
-        Node<char, int>* n1 = new Node<char, int>;
-        Node<char, int>* n2 = new Node<char, int>;
-        Node<char, int>* n3 = new Node<char, int>;
+        Node<char, int>* n1 = pool.create();
+        Node<char, int>* n2 = pool.create();
+        Node<char, int>* n3 = pool.create();
 
         n1->insert(x, y);
 
@@ -430,4 +353,66 @@ namespace {
         EXPECT_EQ(n2->getRightParentElement().key, 'M');
         EXPECT_EQ(n3->getLeftParentElement().key, 'M');
     }
+
+    TEST(NodeTest, releaseChild) {
+        NodePool<Node<char, int>> pool;
+        Node<char, int>* n1 = pool.create('M', 10);
+        Node<char, int>* n2 = pool.create('A', 20);
+        Node<char, int>* n3 = pool.create('Z', 30);
+
+        n1->insert(n2);
+        n1->insert(n3);
+        n2->setParent(n1);
+        n3->setParent(n1);
+
+        EXPECT_EQ(n1->release(n2), n2);
+        EXPECT_EQ(n1->getNumChildren(), 1);
+        EXPECT_EQ(n1->getChild(0), n3);
+        EXPECT_EQ(n2->getParent(), nullptr);
+        EXPECT_EQ(n2->getElement(0).key, 'A');
+        EXPECT_THROW(n1->release(n2), std::string);
+    }
+
+    TEST(NodeTest, insertChildAtIndex) {
+        NodePool<Node<char, int>> pool;
+        Node<char, int> n('M', 10);
+        Node<char, int>* n2 = pool.create('A', 20);
+        Node<char, int>* n3 = pool.create('A', 30);
+        Node<char, int>* n4 = pool.create('A', 40);
+
+        n.insert(n2, 0);
+        n.insert(n3, 0);
+        n.insert(n4, 1);
+
+        EXPECT_EQ(n.getChild(0), n3);
+        EXPECT_EQ(n.getChild(1), n4);
+        EXPECT_EQ(n.getChild(2), n2);
+        EXPECT_THROW(n.insert(n2, 5), std::string);
+        EXPECT_THROW(n.insert(nullptr, 0), std::string);
+    }
+
+    TEST(NodeTest, keysAndValues) {
+        Node<int, std::string> n;
+        n.insert(20, "twenty");
+        n.insert(10, "ten");
+
+        EXPECT_EQ(n.getKey(0), 10);
+        EXPECT_EQ(n.getValue(0), "ten");
+        EXPECT_EQ(n.getKey(1), 20);
+        EXPECT_EQ(n.getValue(1), "twenty");
+        EXPECT_THROW(n.getKey(2), std::string);
+        EXPECT_THROW(n.getValue(2), std::string);
+
+        n.getValue(1) = "TWENTY";
+        EXPECT_EQ(n.getElement(1).value, "TWENTY");
+
+        Element<int, std::string> e = {15, "fifteen"};
+        n.setElement(1, e);
+        EXPECT_EQ(n.getMaximumElement().key, 15);
+        EXPECT_EQ(n.getMaximumElement().value, "fifteen");
+        EXPECT_THROW(n.setElement(2, e), std::string);
+
+        // Keys start on their own cache line
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&n.getKey(0)) % 64, 0u);
+    }
 }
@@ -0,0 +1,177 @@
+#include "PairingHeap.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+    TEST(PairingHeapTest, insertAndExtract) {
+        int k[10] = {5, 3, 2, 6, 8, 9, 0, 1, 4, 7};
+        PairingHeap<int> h;
+
+        for (int i = 0; i < 10; ++i) {
+            h.insert(k[i]);
+        }
+
+        EXPECT_EQ(h.size(), 10);
+        EXPECT_EQ(h.peekKey(), 0);
+
+        for (int i = 0; i < 10; ++i) {
+            EXPECT_EQ(h.extractMin(), i);
+        }
+
+        EXPECT_TRUE(h.empty());
+    }
+
+    TEST(PairingHeapTest, strings) {
+        PairingHeap<std::string> h;
+        std::vector<std::string> expected;
+
+        for (int i = 0; i < 500; ++i) {
+            std::string s = std::to_string((i * 7919) % 500) + std::string(30, 'x');
+            h.insert(s);
+            expected.push_back(s);
+        }
+
+        std::sort(expected.begin(), expected.end());
+
+        for (int i = 0; i < 250; ++i) {
+            EXPECT_EQ(h.extractMin(), expected[i]);
+        }
+
+        // The rest are destroyed with the heap
+        EXPECT_EQ(h.size(), 250);
+    }
+
+    TEST(PairingHeapTest, decreaseKey) {
+        PairingHeap<int> h;
+        PairingHeap<int>::Handle handles[100];
+
+        for (int i = 0; i < 100; ++i) {
+            handles[i] = h.insert(i * 10);
+        }
+
+        h.extractMin();
+        h.decreaseKey(handles[50], -1);
+        EXPECT_EQ(h.peekKey(), -1);
+
+        // Lowering the root keeps it the root
+        h.decreaseKey(handles[50], -2);
+        EXPECT_EQ(h.extractMin(), -2);
+
+        h.decreaseKey(handles[99], 15);
+        h.decreaseKey(handles[98], 15);
+
+        try {
+            h.decreaseKey(handles[97], 971);
+            FAIL();
+        }
+
+        catch (std::string e) {
+            EXPECT_EQ(e, "PHD1");
+        }
+
+        EXPECT_EQ(h.extractMin(), 10);
+        EXPECT_EQ(h.extractMin(), 15);
+        EXPECT_EQ(h.extractMin(), 15);
+
+        for (int i = 2; i < 98; ++i) {
+            if (i != 50) {
+                EXPECT_EQ(h.extractMin(), i * 10);
+            }
+        }
+
+        EXPECT_TRUE(h.empty());
+    }
+
+    TEST(PairingHeapTest, meld) {
+        PairingHeap<int> h1;
+        PairingHeap<int> h2;
+        PairingHeap<int>::Handle handle;
+
+        for (int i = 0; i < 50; ++i) {
+            h1.insert(2 * i);
+            handle = h2.insert(2 * i + 1);
+        }
+
+        h1.meld(h2);
+        EXPECT_EQ(h1.size(), 100);
+        EXPECT_TRUE(h2.empty());
+
+        // Handles from h2 now belong to h1
+        h1.decreaseKey(handle, -1);
+        EXPECT_EQ(h1.extractMin(), -1);
+
+        for (int i = 0; i < 99; ++i) {
+            EXPECT_EQ(h1.extractMin(), i);
+        }
+
+        // h2 is still usable
+        h2.insert(3);
+        EXPECT_EQ(h2.extractMin(), 3);
+    }
+
+    TEST(PairingHeapTest, random) {
+        // Each key carries the index of its entry in the low 20 bits, so
+        // keys are distinct and an extracted key names the entry it came from
+        PairingHeap<long long> h;
+        std::vector<PairingHeap<long long>::Handle> handles;
+        std::vector<long long> keys;
+        std::vector<bool> live;
+        int numLive = 0;
+        std::srand(1);
+
+        for (int step = 0; step < 20000; ++step) {
+            int op = std::rand() % 4;
+
+            if (numLive == 0 || op <= 1) {
+                long long k = (10000000 + std::rand() % 100000) * (1LL << 20) + (long long) keys.size();
+                handles.push_back(h.insert(k));
+                keys.push_back(k);
+                live.push_back(true);
+                ++numLive;
+            }
+
+            else if (op == 2) {
+                long long min = -1;
+
+                for (int i = 0; i < (int) keys.size(); ++i) {
+                    if (live[i] && (min == -1 || keys[i] < min)) {
+                        min = keys[i];
+                    }
+                }
+
+                ASSERT_EQ(h.extractMin(), min);
+                live[min & ((1 << 20) - 1)] = false;
+                --numLive;
+            }
+
+            else {
+                int i = std::rand() % keys.size();
+
+                if (live[i]) {
+                    keys[i] -= (std::rand() % 1000) * (1LL << 20);
+                    h.decreaseKey(handles[i], keys[i]);
+                }
+            }
+
+            ASSERT_EQ(h.size(), numLive);
+        }
+    }
+
+    TEST(PairingHeapTest, empty) {
+        PairingHeap<int> h;
+
+        try {
+            h.peekKey();
+            FAIL();
+        }
+
+        catch (std::string e) {
+            EXPECT_EQ(e, "PHE1");
+        }
+
+        EXPECT_THROW(h.extractMin(), std::string);
+    }
+}
@@ -0,0 +1,163 @@
+#include "PriorityQueue.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+namespace {
+    // Counts copies, so tests can check that sifting never touches payloads
+    struct Payload {
+        static int copies;
+        int id;
+        char padding[120];
+
+        Payload() : id(0) {}
+        Payload(int i) : id(i) {}
+        Payload(const Payload & other) : id(other.id) { ++copies; }
+        Payload(Payload && other) noexcept : id(other.id) {}
+        Payload & operator=(const Payload & other) { id = other.id; ++copies; return *this; }
+        Payload & operator=(Payload && other) noexcept { id = other.id; return *this; }
+    };
+
+    int Payload::copies = 0;
+
+    TEST(PriorityQueueTest, insertAndExtract) {
+        int k[10] = {5, 3, 2, 6, 8, 9, 0, 1, 4, 7};
+        PriorityQueue<int, std::string> q;
+
+        for (int i = 0; i < 10; ++i) {
+            q.insert(k[i], std::to_string(k[i] * 10));
+        }
+
+        EXPECT_EQ(q.size(), 10);
+        EXPECT_EQ(q.peekKey(), 0);
+        EXPECT_EQ(q.peekValue(), "0");
+
+        for (int i = 0; i < 10; ++i) {
+            Element<int, std::string> e = q.extractMin();
+            EXPECT_EQ(e.key, i);
+            EXPECT_EQ(e.value, std::to_string(i * 10));
+        }
+
+        EXPECT_TRUE(q.empty());
+    }
+
+    TEST(PriorityQueueTest, heapify) {
+        Element<int, char> e[8] = {{4, 'e'}, {7, 'h'}, {1, 'b'}, {0, 'a'}, {6, 'g'}, {2, 'c'}, {5, 'f'}, {3, 'd'}};
+        PriorityQueue<int, char, std::less<int>, 4> q(e, 8);
+
+        for (int i = 0; i < 8; ++i) {
+            Element<int, char> min = q.extractMin();
+            EXPECT_EQ(min.key, i);
+            EXPECT_EQ(min.value, 'a' + i);
+        }
+    }
+
+    TEST(PriorityQueueTest, maxOrdering) {
+        MaxPriorityQueue<double, int> q;
+
+        for (int i = 0; i < 100; ++i) {
+            q.insert((i * 37) % 100 / 4.0, i);
+        }
+
+        double previous = q.peekKey();
+
+        while (!q.empty()) {
+            Element<double, int> e = q.extractMin();
+            EXPECT_LE(e.key, previous);
+            EXPECT_EQ(e.key, (e.value * 37) % 100 / 4.0);
+            previous = e.key;
+        }
+    }
+
+    TEST(PriorityQueueTest, comparator) {
+        // Orders strings by length, with a stateful comparator
+        struct ByLength {
+            bool reverse;
+
+            bool operator()(const std::string & a, const std::string & b) const {
+                return reverse ? a.size() > b.size() : a.size() < b.size();
+            }
+        };
+
+        PriorityQueue<std::string, int, ByLength, 3> shortest(ByLength{false});
+        PriorityQueue<std::string, int, ByLength, 3> longest(ByLength{true});
+        std::string words[5] = {"ccc", "a", "eeeee", "bb", "dddd"};
+
+        for (int i = 0; i < 5; ++i) {
+            shortest.insert(words[i], i);
+            longest.insert(words[i], i);
+        }
+
+        EXPECT_EQ(shortest.extractMin().key, "a");
+        EXPECT_EQ(shortest.extractMin().key, "bb");
+        EXPECT_EQ(longest.extractMin().key, "eeeee");
+        EXPECT_EQ(longest.extractMin().value, 4);
+    }
+
+    TEST(PriorityQueueTest, payloadsNotCopied) {
+        PriorityQueue<int, Payload> q;
+        std::srand(1);
+
+        for (int i = 0; i < 1000; ++i) {
+            int k = std::rand() % 1000;
+            q.insert(k, Payload(k));
+        }
+
+        for (int i = 0; i < 1000; ++i) {
+            if (i % 2 == 0) {
+                int k = std::rand() % 1000;
+                q.insert(k, Payload(k));
+            }
+
+            Element<int, Payload> e = q.extractMin();
+            EXPECT_EQ(e.key, e.value.id);
+        }
+
+        EXPECT_EQ(Payload::copies, 0);
+        EXPECT_EQ(q.size(), 500);
+    }
+
+    TEST(PriorityQueueTest, random) {
+        PriorityQueue<int, int, std::less<int>, 8> q;
+        std::vector<int> expected;
+        std::srand(2);
+
+        for (int step = 0; step < 20000; ++step) {
+            if (expected.empty() || std::rand() % 3 != 0) {
+                int k = std::rand() % 500;
+                q.insert(k, -k);
+                expected.push_back(k);
+                std::push_heap(expected.begin(), expected.end(), std::greater<int>());
+            }
+
+            else {
+                Element<int, int> e = q.extractMin();
+                ASSERT_EQ(e.key, expected.front());
+                ASSERT_EQ(e.value, -e.key);
+                std::pop_heap(expected.begin(), expected.end(), std::greater<int>());
+                expected.pop_back();
+            }
+
+            ASSERT_EQ(q.size(), (int) expected.size());
+        }
+    }
+
+    TEST(PriorityQueueTest, empty) {
+        PriorityQueue<int, int> q;
+
+        try {
+            q.peekKey();
+            FAIL();
+        }
+
+        catch (std::string e) {
+            EXPECT_EQ(e, "PQE1");
+        }
+
+        EXPECT_THROW(q.peekValue(), std::string);
+        EXPECT_THROW(q.extractMin(), std::string);
+    }
+}
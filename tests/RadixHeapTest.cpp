@@ -0,0 +1,146 @@
+#include "RadixHeap.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace {
+    TEST(RadixHeapTest, insertAndExtract) {
+        unsigned int k[10] = {5, 3, 2, 6, 8, 9, 0, 1, 4, 7};
+        RadixHeap<unsigned int> h;
+
+        for (int i = 0; i < 10; ++i) {
+            h.insert(k[i]);
+        }
+
+        EXPECT_EQ(h.size(), 10);
+        EXPECT_EQ(h.peekKey(), 0u);
+
+        for (unsigned int i = 0; i < 10; ++i) {
+            EXPECT_EQ(h.extractMin(), i);
+        }
+
+        EXPECT_TRUE(h.empty());
+    }
+
+    TEST(RadixHeapTest, duplicatesAndExtremes) {
+        RadixHeap<std::uint64_t> h;
+        std::uint64_t largest = std::numeric_limits<std::uint64_t>::max();
+
+        h.insert(largest);
+        h.insert(7);
+        h.insert(7);
+        h.insert(largest - 1);
+
+        EXPECT_EQ(h.extractMin(), 7u);
+        h.insert(7);
+        EXPECT_EQ(h.extractMin(), 7u);
+        EXPECT_EQ(h.extractMin(), 7u);
+        EXPECT_EQ(h.extractMin(), largest - 1);
+        h.insert(largest);
+        EXPECT_EQ(h.extractMin(), largest);
+        EXPECT_EQ(h.extractMin(), largest);
+        EXPECT_TRUE(h.empty());
+    }
+
+    TEST(RadixHeapTest, monotone) {
+        RadixHeap<std::uint16_t> h;
+        h.insert(100);
+        h.insert(200);
+        h.extractMin();
+
+        // Keys at the last one extracted are fine, smaller ones are not
+        h.insert(100);
+        EXPECT_EQ(h.peekKey(), 100u);
+
+        try {
+            h.insert(99);
+            FAIL();
+        }
+
+        catch (std::string e) {
+            EXPECT_EQ(e, "RHI1");
+        }
+
+        EXPECT_EQ(h.size(), 2);
+    }
+
+    TEST(RadixHeapTest, peekThenInsertLower) {
+        // Peeking at the next deadline doesn't stop an earlier timer being scheduled
+        RadixHeap<unsigned int> h;
+        h.insert(100);
+        EXPECT_EQ(h.peekKey(), 100u);
+
+        h.insert(60);
+        EXPECT_EQ(h.peekKey(), 60u);
+        h.insert(80);
+        EXPECT_EQ(h.peekKey(), 60u);
+
+        EXPECT_EQ(h.extractMin(), 60u);
+        EXPECT_EQ(h.peekKey(), 80u);
+        h.insert(70);
+        h.insert(60);
+        EXPECT_EQ(h.peekKey(), 60u);
+        EXPECT_THROW(h.insert(59), std::string);
+
+        EXPECT_EQ(h.extractMin(), 60u);
+        EXPECT_EQ(h.extractMin(), 70u);
+        EXPECT_EQ(h.extractMin(), 80u);
+        EXPECT_EQ(h.extractMin(), 100u);
+        EXPECT_TRUE(h.empty());
+    }
+
+    TEST(RadixHeapTest, timerQueue) {
+        // Each step fires the earliest timer and schedules one later than it
+        RadixHeap<std::uint32_t> h;
+        std::vector<std::uint32_t> expected;
+        std::srand(1);
+
+        for (int i = 0; i < 1000; ++i) {
+            std::uint32_t t = std::rand() % 100000;
+            h.insert(t);
+            expected.push_back(t);
+            std::push_heap(expected.begin(), expected.end(), std::greater<std::uint32_t>());
+        }
+
+        for (int step = 0; step < 50000; ++step) {
+            ASSERT_EQ(h.peekKey(), expected.front());
+            std::uint32_t now = h.extractMin();
+            ASSERT_EQ(now, expected.front());
+            std::pop_heap(expected.begin(), expected.end(), std::greater<std::uint32_t>());
+            expected.pop_back();
+
+            for (int i = std::rand() % 3; i > 0; --i) {
+                std::uint32_t t = now + std::rand() % 100000;
+                h.insert(t);
+                expected.push_back(t);
+                std::push_heap(expected.begin(), expected.end(), std::greater<std::uint32_t>());
+            }
+
+            ASSERT_EQ(h.size(), (int) expected.size());
+
+            if (expected.empty()) {
+                break;
+            }
+        }
+    }
+
+    TEST(RadixHeapTest, empty) {
+        RadixHeap<unsigned int> h;
+
+        try {
+            h.peekKey();
+            FAIL();
+        }
+
+        catch (std::string e) {
+            EXPECT_EQ(e, "RHE1");
+        }
+
+        EXPECT_THROW(h.extractMin(), std::string);
+    }
+}
@@ -0,0 +1,250 @@
+#include "SPSCQueue.h"
+#include "GrowableSPSCQueue.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    TEST(SPSCQueueTest, capacity) {
+        SPSCQueue<int> q1(1);
+        SPSCQueue<int> q2(100);
+        SPSCQueue<int> q3(128);
+
+        EXPECT_EQ(q1.Capacity(), 1);
+        EXPECT_EQ(q2.Capacity(), 128);
+        EXPECT_EQ(q3.Capacity(), 128);
+
+        EXPECT_THROW(SPSCQueue<int> q4(0), std::string);
+    }
+
+    TEST(SPSCQueueTest, pushAndPop) {
+        SPSCQueue<int> q(4);
+        int v;
+
+        EXPECT_TRUE(q.Empty());
+        EXPECT_FALSE(q.TryPop(v));
+
+        // Go around the ring several times
+        for (int round = 0; round < 10; ++round) {
+            for (int i = 0; i < 4; ++i) {
+                EXPECT_TRUE(q.TryPush(round * 4 + i));
+            }
+
+            EXPECT_FALSE(q.TryPush(-1));
+            EXPECT_EQ(q.Length(), 4);
+
+            for (int i = 0; i < 4; ++i) {
+                EXPECT_TRUE(q.TryPop(v));
+                EXPECT_EQ(v, round * 4 + i);
+            }
+
+            EXPECT_FALSE(q.TryPop(v));
+        }
+    }
+
+    TEST(SPSCQueueTest, batch) {
+        SPSCQueue<std::string> q(8);
+        std::string items[12];
+
+        for (int i = 0; i < 12; ++i) {
+            items[i] = std::to_string(i);
+        }
+
+        EXPECT_EQ(q.PushBatch(items, 5), 5);
+        EXPECT_EQ(q.PushBatch(items + 5, 7), 3);
+        EXPECT_EQ(q.Length(), 8);
+
+        std::string popped[12];
+        EXPECT_EQ(q.PopBatch(popped, 6), 6);
+        EXPECT_EQ(q.PushBatch(items + 8, 4), 4);
+        EXPECT_EQ(q.PopBatch(popped + 6, 12), 6);
+
+        for (int i = 0; i < 12; ++i) {
+            EXPECT_EQ(popped[i], std::to_string(i));
+        }
+
+        EXPECT_EQ(q.PopBatch(popped, 1), 0);
+    }
+
+    TEST(SPSCQueueTest, emptyBatch) {
+        SPSCQueue<int> q(8);
+        int items[3] = {1, 2, 3};
+
+        EXPECT_EQ(q.PushBatch(items, 3), 3);
+        EXPECT_EQ(q.PushBatch(items, 0), 0);
+        EXPECT_EQ(q.PushBatch(items, -1), 0);
+        EXPECT_EQ(q.PopBatch(items, 0), 0);
+        EXPECT_EQ(q.PopBatch(items, -1), 0);
+        EXPECT_EQ(q.Length(), 3);
+
+        int popped[3];
+        EXPECT_EQ(q.PopBatch(popped, 3), 3);
+        EXPECT_EQ(popped[2], 3);
+    }
+
+    TEST(SPSCQueueTest, destroysRemainingElements) {
+        SPSCQueue<std::string> q(4);
+        q.TryEmplace(100, 'a');
+        q.TryPush("b");
+
+        std::string v;
+        q.TryPop(v);
+        EXPECT_EQ(v, std::string(100, 'a'));
+    }
+
+    TEST(SPSCQueueTest, twoThreads) {
+        SPSCQueue<long long> q(64);
+        long long inputSize = 1000000;
+
+        std::thread producer([&q, inputSize]() {
+            for (long long i = 0; i < inputSize; ++i) {
+                while (!q.TryPush(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        long long expected = 0;
+        long long v;
+
+        while (expected < inputSize) {
+            if (q.TryPop(v)) {
+                EXPECT_EQ(v, expected);
+                ++expected;
+            }
+
+            else {
+                std::this_thread::yield();
+            }
+        }
+
+        producer.join();
+        EXPECT_TRUE(q.Empty());
+    }
+
+    TEST(SPSCQueueTest, twoThreadsBatch) {
+        SPSCQueue<int> q(256);
+        int inputSize = 1000000;
+
+        std::thread producer([&q, inputSize]() {
+            int items[100];
+            int next = 0;
+
+            while (next < inputSize) {
+                int count = 0;
+
+                while (count < 100 && next + count < inputSize) {
+                    items[count] = next + count;
+                    ++count;
+                }
+
+                int pushed = 0;
+                while (pushed < count) {
+                    int n = q.PushBatch(items + pushed, count - pushed);
+                    pushed += n;
+
+                    if (n == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+
+                next += count;
+            }
+        });
+
+        int items[64];
+        int expected = 0;
+        bool inOrder = true;
+
+        while (expected < inputSize) {
+            int popped = q.PopBatch(items, 64);
+
+            for (int i = 0; i < popped; ++i) {
+                inOrder = inOrder && (items[i] == expected);
+                ++expected;
+            }
+
+            if (popped == 0) {
+                std::this_thread::yield();
+            }
+        }
+
+        producer.join();
+        EXPECT_TRUE(inOrder);
+    }
+
+    TEST(GrowableSPSCQueueTest, grows) {
+        GrowableSPSCQueue<std::string> q(2);
+
+        for (int i = 0; i < 1000; ++i) {
+            q.Push(std::to_string(i));
+        }
+
+        std::string v;
+
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_TRUE(q.TryPop(v));
+            EXPECT_EQ(v, std::to_string(i));
+        }
+
+        EXPECT_FALSE(q.TryPop(v));
+
+        q.Emplace(3, 'x');
+        EXPECT_TRUE(q.TryPop(v));
+        EXPECT_EQ(v, "xxx");
+
+        // Leave some behind for the destructor
+        for (int i = 0; i < 100; ++i) {
+            q.Push(std::to_string(i));
+        }
+    }
+
+    TEST(GrowableSPSCQueueTest, batch) {
+        GrowableSPSCQueue<int> q(4);
+        int items[1000];
+
+        for (int i = 0; i < 1000; ++i) {
+            items[i] = i;
+        }
+
+        q.PushBatch(items, 3);
+        q.PushBatch(items + 3, 997);
+
+        int popped[1000];
+        EXPECT_EQ(q.PopBatch(popped, 10), 10);
+        EXPECT_EQ(q.PopBatch(popped + 10, 1000), 990);
+
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_EQ(popped[i], i);
+        }
+
+        EXPECT_EQ(q.PopBatch(popped, 10), 0);
+    }
+
+    TEST(GrowableSPSCQueueTest, twoThreads) {
+        GrowableSPSCQueue<int> q(4);
+        int inputSize = 1000000;
+
+        std::thread producer([&q, inputSize]() {
+            for (int i = 0; i < inputSize; ++i) {
+                q.Push(i);
+            }
+        });
+
+        int expected = 0;
+        int v;
+        bool inOrder = true;
+
+        while (expected < inputSize) {
+            if (q.TryPop(v)) {
+                inOrder = inOrder && (v == expected);
+                ++expected;
+            }
+        }
+
+        producer.join();
+        EXPECT_TRUE(inOrder);
+        EXPECT_FALSE(q.TryPop(v));
+    }
+}
@@ -7,6 +7,7 @@
 #include <sstream>
 #include <iostream>
 #include <string>
+#include <set>
 
 namespace {
     TEST(Two4TreeTest, defaultConstructor) {
@@ -717,4 +718,101 @@ namespace {
             EXPECT_EQ(t.select(t.rank(x2[i])), i);
         }
     }
-}
\ No newline at end of file
+
+    void collectNodes(Node<int, int>* topNode, std::set<Node<int, int>*> & nodes) {
+        nodes.insert(topNode);
+
+        for (int i = 0; i < topNode->getNumChildren(); ++i) {
+            collectNodes(topNode->getChild(i), nodes);
+        }
+    }
+
+    // Splits should move existing subtrees, never replace them with copies
+    TEST(Two4TreeTest, splitRelinksSubtrees) {
+        Two4Tree<int, int> t;
+
+        int inputSize = 1000;
+
+        for (int i = 0; i < inputSize; ++i) {
+            t.insert(i, i);
+        }
+
+        std::set<Node<int, int>*> before;
+        collectNodes(t.getRoot(), before);
+
+        for (int i = inputSize; i < 2 * inputSize; ++i) {
+            t.insert(i, i);
+        }
+
+        std::set<Node<int, int>*> after;
+        collectNodes(t.getRoot(), after);
+
+        for (Node<int, int>* node : before) {
+            EXPECT_EQ(after.count(node), 1);
+        }
+
+        parentTest(t.getRoot());
+        EXPECT_EQ(t.size(), 2 * inputSize);
+    }
+
+    TEST(Two4TreeTest, removeRelinksSubtrees) {
+        std::vector<int> x;
+        int inputSize = 5000;
+
+        for (int i = 0; i < inputSize; ++i) {
+            x.push_back(i);
+        }
+
+        Two4Tree<int, int> t;
+        for (int i = 0; i < inputSize; ++i) {
+            t.insert(x.at(i), x.at(i));
+        }
+
+        std::random_shuffle(x.begin(), x.end());
+
+        for (int i = 0; i < inputSize / 2; ++i) {
+            EXPECT_EQ(t.remove(x.at(i)), 1);
+        }
+
+        parentTest(t.getRoot());
+        EXPECT_EQ(t.size(), inputSize - inputSize / 2);
+
+        for (int i = inputSize / 2; i < inputSize; ++i) {
+            EXPECT_EQ(*t.search(x.at(i)), x.at(i));
+        }
+    }
+
+    TEST(Two4TreeTest, nodePool) {
+        Two4Tree<int, std::string> t;
+
+        int inputSize = 10000;
+
+        for (int i = 0; i < inputSize; ++i) {
+            t.insert(i, std::to_string(i));
+        }
+
+        std::set<Node<int, std::string>*> nodes;
+        std::vector<Node<int, std::string>*> stack = {t.getRoot()};
+        while (!stack.empty()) {
+            Node<int, std::string>* node = stack.back();
+            stack.pop_back();
+            nodes.insert(node);
+
+            for (int i = 0; i < node->getNumChildren(); ++i) {
+                stack.push_back(node->getChild(i));
+            }
+        }
+
+        EXPECT_EQ(t.getPool().getLiveNodes(), (int) nodes.size());
+        EXPECT_GT(t.getPool().getSlabCount(), 0);
+
+        for (int i = 0; i < inputSize; ++i) {
+            t.remove(i);
+        }
+
+        EXPECT_EQ(t.getPool().getLiveNodes(), 1);
+
+        Two4Tree<int, std::string> t2(t);
+        EXPECT_EQ(t2.getPool().getLiveNodes(), 1);
+    }
+}
@@ -0,0 +1,186 @@
+#include "WorkStealingDeque.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    TEST(WorkStealingDequeTest, capacity) {
+        WorkStealingDeque<int> d1(1);
+        WorkStealingDeque<int> d2(100);
+
+        EXPECT_EQ(d1.Capacity(), 1);
+        EXPECT_EQ(d2.Capacity(), 128);
+
+        EXPECT_THROW(WorkStealingDeque<int> d3(0), std::string);
+    }
+
+    // The owner sees the newest element and thieves see the oldest
+    TEST(WorkStealingDequeTest, popAndSteal) {
+        WorkStealingDeque<int> d(8);
+        int v;
+
+        EXPECT_TRUE(d.Empty());
+        EXPECT_FALSE(d.TryPop(v));
+        EXPECT_FALSE(d.TrySteal(v));
+
+        for (int i = 0; i < 6; ++i) {
+            d.Push(i);
+        }
+
+        EXPECT_EQ(d.Length(), 6);
+
+        EXPECT_TRUE(d.TryPop(v));
+        EXPECT_EQ(v, 5);
+        EXPECT_TRUE(d.TrySteal(v));
+        EXPECT_EQ(v, 0);
+        EXPECT_TRUE(d.TrySteal(v));
+        EXPECT_EQ(v, 1);
+        EXPECT_TRUE(d.TryPop(v));
+        EXPECT_EQ(v, 4);
+        EXPECT_TRUE(d.TryPop(v));
+        EXPECT_EQ(v, 3);
+        EXPECT_TRUE(d.TrySteal(v));
+        EXPECT_EQ(v, 2);
+
+        EXPECT_FALSE(d.TryPop(v));
+        EXPECT_FALSE(d.TrySteal(v));
+        EXPECT_TRUE(d.Empty());
+    }
+
+    // Growing keeps the elements in order, even after the counters have wrapped the ring
+    TEST(WorkStealingDequeTest, grow) {
+        WorkStealingDeque<int> d(4);
+        int v;
+
+        for (int i = 0; i < 3; ++i) {
+            d.Push(i);
+            d.TrySteal(v);
+        }
+
+        for (int i = 0; i < 100; ++i) {
+            d.Push(i);
+        }
+
+        EXPECT_EQ(d.Capacity(), 128);
+        EXPECT_EQ(d.Length(), 100);
+
+        for (int i = 0; i < 50; ++i) {
+            EXPECT_TRUE(d.TrySteal(v));
+            EXPECT_EQ(v, i);
+        }
+
+        for (int i = 99; i >= 50; --i) {
+            EXPECT_TRUE(d.TryPop(v));
+            EXPECT_EQ(v, i);
+        }
+
+        EXPECT_TRUE(d.Empty());
+    }
+
+    // Every element is taken exactly once while the owner pushes, pops and
+    // grows the buffer and several thieves steal at the same time
+    TEST(WorkStealingDequeTest, concurrentSteal) {
+        const int numThieves = 3;
+        const int numItems = 100000;
+        WorkStealingDeque<int> d(2);
+        std::vector<std::atomic<int>> taken(numItems);
+        std::atomic<bool> done(false);
+
+        for (std::atomic<int> & count : taken) {
+            count.store(0);
+        }
+
+        std::vector<std::thread> thieves;
+
+        for (int i = 0; i < numThieves; ++i) {
+            thieves.emplace_back([&d, &taken, &done]() {
+                int v;
+
+                while (!done.load() || !d.Empty()) {
+                    if (d.TrySteal(v)) {
+                        ++taken[v];
+                    }
+                }
+            });
+        }
+
+        int v;
+
+        for (int i = 0; i < numItems; ++i) {
+            d.Push(i);
+
+            // Pop every third element back
+            if (i % 3 == 0 && d.TryPop(v)) {
+                ++taken[v];
+            }
+        }
+
+        while (d.TryPop(v)) {
+            ++taken[v];
+        }
+
+        done.store(true);
+
+        for (std::thread & t : thieves) {
+            t.join();
+        }
+
+        for (int i = 0; i < numItems; ++i) {
+            EXPECT_EQ(taken[i].load(), 1);
+        }
+    }
+
+    // The owner and its thieves split up recursive work, as a task scheduler would
+    TEST(WorkStealingDequeTest, splitWork) {
+        const int numThreads = 4;
+        const int leaves = 1 << 14;
+        std::vector<WorkStealingDeque<long long>> deques(numThreads);
+        std::atomic<long long> sum(0);
+        std::atomic<int> finished(0);
+
+        // A task is a range [first, last) packed into one integer
+        deques[0].Push(static_cast<long long>(leaves));
+
+        std::vector<std::thread> threads;
+
+        for (int i = 0; i < numThreads; ++i) {
+            threads.emplace_back([&deques, &sum, &finished, i]() {
+                long long task;
+
+                while (finished.load() < leaves) {
+                    bool found = deques[i].TryPop(task);
+
+                    for (int j = 1; !found && j < numThreads; ++j) {
+                        found = deques[(i + j) % numThreads].TrySteal(task);
+                    }
+
+                    if (!found) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    long long first = task >> 32;
+                    long long last = task & 0xFFFFFFFF;
+
+                    // Split in half, keep one half, and offer the other to thieves
+                    while (last - first > 1) {
+                        long long middle = (first + last) / 2;
+                        deques[i].Push((middle << 32) | last);
+                        last = middle;
+                    }
+
+                    sum += first;
+                    ++finished;
+                }
+            });
+        }
+
+        for (std::thread & t : threads) {
+            t.join();
+        }
+
+        EXPECT_EQ(sum.load(), static_cast<long long>(leaves) * (leaves - 1) / 2);
+    }
+}